@@ -28,6 +28,7 @@ function! GayaIndent(lnum)
     if current_line =~ '^\s*end\s*$'
       \ && (
         \ previous_line =~ 'do\s*$'
+        \ || previous_line =~ 'gen\s*$'
         \ || previous_line =~ 'cases\s*$'
         \ || previous_line =~ '^\s*for'
         \ || previous_line =~ '^\s*while'
@@ -42,6 +43,7 @@ function! GayaIndent(lnum)
 
     if previous_line =~ '=>\s*$'
        \ || previous_line =~ 'do\s*$'
+       \ || previous_line =~ 'gen\s*$'
        \ || previous_line =~ 'cases\s*$'
        \ || previous_line =~ '^\s*for'
        \ || previous_line =~ '^\s*while'
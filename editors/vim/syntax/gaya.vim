@@ -10,7 +10,7 @@ syntax keyword gayaConstant true false
 highlight link gayaConstant Constant
 
 " Keywords
-syntax keyword gayaKeyword let in do unit cases end given otherwise while perform and or not include when for type of with struct enum upto
+syntax keyword gayaKeyword let in do unit cases end given otherwise while perform and or not include when for type of with struct enum upto gen yield
 highlight link gayaKeyword Keyword
 
 " Literals
@@ -101,11 +101,13 @@ struct for_in_stmt final : public stmt
         span s,
         std::shared_ptr<identifier> i,
         expression_ptr seq,
-        std::vector<stmt_ptr> b)
+        std::vector<stmt_ptr> b,
+        std::shared_ptr<identifier> v = nullptr)
         : span_ { s }
         , ident { i }
         , sequence { seq }
         , body { b }
+        , value_ident { v }
     {
     }
 
@@ -115,6 +117,9 @@ struct for_in_stmt final : public stmt
     std::shared_ptr<identifier> ident;
     expression_ptr sequence;
     std::vector<stmt_ptr> body;
+
+    /* The second identifier of a `for (k, v) in d` loop, if any. */
+    std::shared_ptr<identifier> value_ident;
 };
 
 struct include_stmt final : public stmt
@@ -452,6 +457,35 @@ struct perform_expression final : public expression
     stmt_ptr stmt;
 };
 
+struct generator_expression final : public expression
+{
+    generator_expression(span s, expression_ptr b)
+        : span_ { s }
+        , body { std::move(b) }
+    {
+    }
+
+    object accept(ast_visitor&) override;
+
+    // The body is a do block that is run a step at a time, up to each yield.
+    span span_;
+    expression_ptr body;
+};
+
+struct yield_expression final : public expression
+{
+    yield_expression(span s, expression_ptr e)
+        : span_ { s }
+        , expr { std::move(e) }
+    {
+    }
+
+    object accept(ast_visitor&) override;
+
+    span span_;
+    expression_ptr expr;
+};
+
 /* Primary expressions */
 
 struct array final : public expression
@@ -26,27 +26,29 @@ public:
     virtual ResultType visit_enum_declaration(EnumDeclaration&)     = 0;
 
     /* Expressions */
-    virtual ResultType visit_do_expression(do_expression&)             = 0;
-    virtual ResultType visit_case_expression(case_expression&)         = 0;
-    virtual ResultType visit_match_expression(match_expression&)       = 0;
-    virtual ResultType visit_get_expression(get_expression&)           = 0;
-    virtual ResultType visit_call_expression(call_expression&)         = 0;
-    virtual ResultType visit_function_expression(function_expression&) = 0;
-    virtual ResultType visit_let_expression(let_expression&)           = 0;
-    virtual ResultType visit_binary_expression(binary_expression&)     = 0;
-    virtual ResultType visit_add_numbers(AddNumbers&)                  = 0;
-    virtual ResultType visit_less_than_numbers(LessThanNumbers&)       = 0;
-    virtual ResultType visit_lnot_expression(lnot_expression&)         = 0;
-    virtual ResultType visit_not_expression(not_expression&)           = 0;
-    virtual ResultType visit_perform_expression(perform_expression&)   = 0;
-    virtual ResultType visit_array(array&)                             = 0;
-    virtual ResultType visit_dictionary(dictionary&)                   = 0;
-    virtual ResultType visit_number(number&)                           = 0;
-    virtual ResultType visit_string(string&)                           = 0;
-    virtual ResultType visit_identifier(identifier&)                   = 0;
-    virtual ResultType visit_unit(unit&)                               = 0;
-    virtual ResultType visit_placeholder(placeholder&)                 = 0;
-    virtual ResultType visit_upto(Upto&)                               = 0;
+    virtual ResultType visit_do_expression(do_expression&)               = 0;
+    virtual ResultType visit_case_expression(case_expression&)           = 0;
+    virtual ResultType visit_match_expression(match_expression&)         = 0;
+    virtual ResultType visit_get_expression(get_expression&)             = 0;
+    virtual ResultType visit_call_expression(call_expression&)           = 0;
+    virtual ResultType visit_function_expression(function_expression&)   = 0;
+    virtual ResultType visit_let_expression(let_expression&)             = 0;
+    virtual ResultType visit_binary_expression(binary_expression&)       = 0;
+    virtual ResultType visit_add_numbers(AddNumbers&)                    = 0;
+    virtual ResultType visit_less_than_numbers(LessThanNumbers&)         = 0;
+    virtual ResultType visit_lnot_expression(lnot_expression&)           = 0;
+    virtual ResultType visit_not_expression(not_expression&)             = 0;
+    virtual ResultType visit_perform_expression(perform_expression&)     = 0;
+    virtual ResultType visit_generator_expression(generator_expression&) = 0;
+    virtual ResultType visit_yield_expression(yield_expression&)         = 0;
+    virtual ResultType visit_array(array&)                               = 0;
+    virtual ResultType visit_dictionary(dictionary&)                     = 0;
+    virtual ResultType visit_number(number&)                             = 0;
+    virtual ResultType visit_string(string&)                             = 0;
+    virtual ResultType visit_identifier(identifier&)                     = 0;
+    virtual ResultType visit_unit(unit&)                                 = 0;
+    virtual ResultType visit_placeholder(placeholder&)                   = 0;
+    virtual ResultType visit_upto(Upto&)                                 = 0;
 };
 
 }
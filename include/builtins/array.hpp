@@ -6,7 +6,7 @@ namespace gaya::eval::object::builtin::array
 {
 
 /**
- * Return the length of an array.
+ * Return the length of an array or a tuple.
  * @param a <array> The array.
  */
 gaya::eval::object::object
@@ -14,7 +14,7 @@ length(interpreter&, span, const std::vector<object>&) noexcept;
 
 /**
  * Append the elements of the second array to the end first one.
- * This mutates the first array.
+ * This mutates the first array, or returns a new one if it is a tuple.
  * @param a1 <array> The array onto which to append elements.
  * @param a2 <array> The array from which to extract elements.
  */
@@ -41,6 +41,7 @@ pop(interpreter&, span, const std::vector<object>&) noexcept;
 /**
  * Sort the provided array in place.
  * The sorting is performed according to the provided comparison function.
+ * A tuple is not changed; a new sorted array is returned instead.
  * @param a <array> The array to sort.
  * @param cmp <function> A comparison function.
  */
@@ -57,4 +58,25 @@ sort(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 set(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Return the elements of an array or tuple from start up to but not including
+ * end.
+ * The slice shares the elements of the array instead of copying them, and
+ * neither sees changes made to the other afterwards.
+ * @param a <array> The array.
+ * @param start <number> The index of the first element of the slice.
+ * @param end <number> The index after the last element of the slice.
+ */
+gaya::eval::object::object
+slice(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a copy of an array, or an array with the elements of a tuple.
+ * The copy shares the elements of the array until either of them changes, so
+ * making one does not depend on the length of the array.
+ * @param a <array> The array to copy.
+ */
+gaya::eval::object::object
+clone(interpreter&, span, const std::vector<object>&) noexcept;
+
 }
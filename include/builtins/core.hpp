@@ -49,4 +49,12 @@ tosequence(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 md5(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Return a tuple with the elements of the provided sequence. Tuples are
+ * returned as they are.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+tuple_(interpreter&, span, const std::vector<object>&) noexcept;
+
 }
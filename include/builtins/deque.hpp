@@ -0,0 +1,65 @@
+#pragma once
+
+#include <object.hpp>
+
+namespace gaya::eval::object::builtin::deque
+{
+
+/**
+ * Return a deque with the elements of the provided sequence. A deque gives a
+ * copy of itself.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+make(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of elements in the provided deque.
+ * @param d <deque> The deque.
+ */
+gaya::eval::object::object
+length(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Add an element to the front of the provided deque.
+ * This mutates the original deque.
+ *
+ * @param d <deque> The deque.
+ * @param x <object> The element to add.
+ * @return The provided deque.
+ */
+gaya::eval::object::object
+push_front(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Add an element to the back of the provided deque.
+ * This mutates the original deque.
+ *
+ * @param d <deque> The deque.
+ * @param x <object> The element to add.
+ * @return The provided deque.
+ */
+gaya::eval::object::object
+push_back(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Remove and return the first element of the provided deque, or unit if it is
+ * empty.
+ * This mutates the original deque.
+ *
+ * @param d <deque> The deque.
+ */
+gaya::eval::object::object
+pop_front(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Remove and return the last element of the provided deque, or unit if it is
+ * empty.
+ * This mutates the original deque.
+ *
+ * @param d <deque> The deque.
+ */
+gaya::eval::object::object
+pop_back(interpreter&, span, const std::vector<object>&) noexcept;
+
+}
@@ -37,6 +37,57 @@ set(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 remove(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Set the value for a key to the result of applying a function to its current
+ * value, or to a default value if the key is not in the dictionary.
+ * This mutates the original dictionary.
+ *
+ * @param dict <dictionary> The dictionary.
+ * @param key <object> The key.
+ * @param func <function> The function that computes the new value.
+ * @param default <object> The value for a key that is not found.
+ * @return The provided dictionary.
+ */
+gaya::eval::object::object
+update(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Add a number to the value for a key, which counts as 0 if the key is not in
+ * the dictionary.
+ * This mutates the original dictionary.
+ *
+ * @param dict <dictionary> The dictionary.
+ * @param key <object> The key.
+ * @param by <number> The number to add.
+ * @return The new value.
+ */
+gaya::eval::object::object
+increment(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the value for a key, inserting the default value first if the key is
+ * not in the dictionary.
+ * This mutates the original dictionary.
+ *
+ * @param dict <dictionary> The dictionary.
+ * @param key <object> The key.
+ * @param default <object> The value for a key that is not found.
+ */
+gaya::eval::object::object
+get_or_insert(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Remove a key from the dictionary and return its value, or the default value
+ * if the key is not in the dictionary.
+ * This mutates the original dictionary.
+ *
+ * @param dict <dictionary> The dictionary.
+ * @param key <object> The key to remove.
+ * @param default <object> The value for a key that is not found.
+ */
+gaya::eval::object::object
+pop(interpreter&, span, const std::vector<object>&) noexcept;
+
 /**
  * Returns a truthy value if the specified key has a corresponding value in the
  * provided dictionary, unit otherwise.
@@ -46,4 +97,34 @@ remove(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 contains(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Return a sequence over the keys of the provided dictionary.
+ * @param dict <dictionary> The dictionary.
+ */
+gaya::eval::object::object
+keys(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over the values of the provided dictionary.
+ * @param dict <dictionary> The dictionary.
+ */
+gaya::eval::object::object
+values(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over the key-value pairs of the provided dictionary.
+ * @param dict <dictionary> The dictionary.
+ */
+gaya::eval::object::object
+items(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a copy of the provided dictionary.
+ * The copy shares the entries of the dictionary until either of them changes,
+ * so making one does not depend on the size of the dictionary.
+ * @param dict <dictionary> The dictionary to copy.
+ */
+gaya::eval::object::object
+clone(interpreter&, span, const std::vector<object>&) noexcept;
+
 }
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <object.hpp>
+
+namespace gaya::eval::object::builtin::grid
+{
+
+/**
+ * Return a grid of the given size with every cell set to the same value.
+ * The size must be whole numbers, and a grid can have at most 2^28 cells.
+ * @param width <number> The number of columns.
+ * @param height <number> The number of rows.
+ * @param fill <object> The value of the cells.
+ */
+gaya::eval::object::object
+make(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a grid with a cell for each character of the lines of a string.
+ * Trailing newlines are ignored, and every line must be as long as the first.
+ * @param s <string> The string.
+ */
+gaya::eval::object::object
+from_string(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of columns of the provided grid.
+ * @param g <grid> The grid.
+ */
+gaya::eval::object::object
+width(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of rows of the provided grid.
+ * @param g <grid> The grid.
+ */
+gaya::eval::object::object
+height(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the cell at a point, or unit if the point is not on the grid.
+ * @param g <grid> The grid.
+ * @param p <point> The column and the row of the cell.
+ */
+gaya::eval::object::object
+get(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Set the cell at a point, which must be on the grid.
+ * This mutates the original grid.
+ *
+ * @param g <grid> The grid.
+ * @param p <point> The column and the row of the cell.
+ * @param x <object> The new value of the cell.
+ * @return The provided grid.
+ */
+gaya::eval::object::object
+set(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the points above, right of, below and left of a point, leaving out
+ * those that are not on the grid.
+ * @param g <grid> The grid.
+ * @param p <point> The point.
+ */
+gaya::eval::object::object
+neighbours(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the points around a point, diagonals included, leaving out those
+ * that are not on the grid.
+ * @param g <grid> The grid.
+ * @param p <point> The point.
+ */
+gaya::eval::object::object
+neighbours8(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the cells of a row as an array.
+ * @param g <grid> The grid.
+ * @param y <number> The row.
+ */
+gaya::eval::object::object
+row(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the cells of a column as an array.
+ * @param g <grid> The grid.
+ * @param x <number> The column.
+ */
+gaya::eval::object::object
+column(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the first point, row by row, whose cell is equal to the given value,
+ * or unit if there is none.
+ * @param g <grid> The grid.
+ * @param x <object> The value.
+ */
+gaya::eval::object::object
+find(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with the points, row by row, whose cells are equal to the
+ * given value.
+ * @param g <grid> The grid.
+ * @param x <object> The value.
+ */
+gaya::eval::object::object
+find_all(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a set with the points of the region that a point is in, which are
+ * those that can be reached from it through neighbours with the same value.
+ * @param g <grid> The grid.
+ * @param p <point> The point, which must be on the grid.
+ */
+gaya::eval::object::object
+flood_fill(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a copy of the provided grid.
+ * @param g <grid> The grid.
+ */
+gaya::eval::object::object
+copy(interpreter&, span, const std::vector<object>&) noexcept;
+
+}
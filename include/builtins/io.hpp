@@ -26,6 +26,19 @@ print(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 readline(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Return a sequence over the lines of standard input, without their newlines.
+ */
+gaya::eval::object::object
+stdin_(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over standard input in chunks of bytes, as they are read.
+ * Chunks may end in the middle of a line.
+ */
+gaya::eval::object::object
+stdin_chunks(interpreter&, span, const std::vector<object>&) noexcept;
+
 /**
  * Read the contents of a file. If the file does not exist, unit is returned.
  * @param filename <string> The name of the file to read.
@@ -33,6 +46,16 @@ readline(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 readfile(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Return a sequence over the lines of a file, without their newlines. The file
+ * is read as the sequence is consumed, but memory still grows with each
+ * distinct line, since lines are interned like every other string and never
+ * freed. If the file does not exist, unit is returned.
+ * @param filename <string> The name of the file to read.
+ */
+gaya::eval::object::object
+lines(interpreter&, span, const std::vector<object>&) noexcept;
+
 /**
  * List the files in the provided directory.
  * @param dirname <String> The name of the directory to list.
@@ -40,4 +63,19 @@ readfile(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 listdir(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Write any buffered output to standard output. Output is also flushed when
+ * the program exits and before reading from standard input.
+ */
+gaya::eval::object::object
+flush(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Set the size in bytes of the buffer that standard output is written
+ * through. A size of 0 disables buffering.
+ * @param size <number> The new size of the buffer.
+ */
+gaya::eval::object::object
+set_buffer_size(interpreter&, span, const std::vector<object>&) noexcept;
+
 }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <object.hpp>
+
+namespace gaya::eval::object::builtin::pq
+{
+
+/**
+ * Return an empty priority queue.
+ */
+gaya::eval::object::object
+make(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of values in the provided queue.
+ * @param q <priority queue> The queue.
+ */
+gaya::eval::object::object
+length(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Add a value to the provided queue.
+ * This mutates the original queue.
+ *
+ * @param q <priority queue> The queue.
+ * @param priority <number> The priority. Lower priorities come out first.
+ * @param value <object> The value.
+ * @return A handle for pq.decrease.
+ */
+gaya::eval::object::object
+push(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Remove the value with the lowest priority from the provided queue and return
+ * it. Values with the same priority come out in the order they were pushed.
+ * This mutates the original queue.
+ *
+ * @param q <priority queue> The queue.
+ * @return The value, or unit if the queue is empty.
+ */
+gaya::eval::object::object
+pop(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the value with the lowest priority, without removing it.
+ * @param q <priority queue> The queue.
+ * @return The value, or unit if the queue is empty.
+ */
+gaya::eval::object::object
+peek(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the lowest priority in the provided queue.
+ * @param q <priority queue> The queue.
+ * @return The priority, or unit if the queue is empty.
+ */
+gaya::eval::object::object
+priority(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Lower the priority of a value that is still in the queue.
+ * This mutates the original queue.
+ *
+ * @param q <priority queue> The queue.
+ * @param handle <number> The handle pq.push returned for the value.
+ * @param priority <number> The new priority.
+ * @return 1 if the priority was lowered, unit if the value was already popped
+ *         or its priority was not higher.
+ */
+gaya::eval::object::object
+decrease(interpreter&, span, const std::vector<object>&) noexcept;
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <object.hpp>
+
+namespace gaya::eval::object::builtin::re
+{
+
+/**
+ * Return the text of the first match of the pattern in the string, or unit if
+ * the pattern does not match.
+ * @param pattern <string> The regular expression.
+ * @param s <string> The string to search.
+ */
+gaya::eval::object::object
+match(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with every non-overlapping match of the pattern in the
+ * string. If the pattern has groups, every element is an array with the text
+ * captured by each group.
+ * @param pattern <string> The regular expression.
+ * @param s <string> The string to search.
+ */
+gaya::eval::object::object
+findall(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with the text captured by each group in the first match of
+ * the pattern, or unit if the pattern does not match. Groups that did not take
+ * part in the match are unit.
+ * @param pattern <string> The regular expression.
+ * @param s <string> The string to search.
+ */
+gaya::eval::object::object
+captures(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Split a string on the matches of the pattern and return an array with the
+ * parts. Empty matches are ignored.
+ * @param pattern <string> The regular expression.
+ * @param s <string> The string to split.
+ */
+gaya::eval::object::object
+split(interpreter&, span, const std::vector<object>&) noexcept;
+
+}
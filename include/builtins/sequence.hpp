@@ -30,4 +30,230 @@ make(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 copy(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Create a sequence that yields the numbers from start inclusive to finish
+ * exclusive.
+ * @param start <number> The first number.
+ * @param finish <number> The number at which to stop.
+ */
+gaya::eval::object::object
+range(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new sequence that maps the given function over the elements of the
+ * provided sequence.
+ * @param xs <sequence> The sequence.
+ * @param func <function> The transformation function.
+ */
+gaya::eval::object::object
+map(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new sequence that filters out elements for which the provided
+ * predicate function returns false.
+ * @param xs <sequence> The sequence.
+ * @param pred <function> The predicate.
+ */
+gaya::eval::object::object
+filter(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence that takes the first n elements of the provided one.
+ * @param xs <sequence> The sequence.
+ * @param n <number> The number of elements to take.
+ */
+gaya::eval::object::object
+take(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new sequence that drops the first n elements of the provided one.
+ * @param xs <sequence> The sequence.
+ * @param n <number> The number of elements to drop.
+ */
+gaya::eval::object::object
+drop(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence that takes elements from the input sequence as long as
+ * they satisfy the given predicate.
+ * @param xs <sequence> The sequence.
+ * @param pred <function> The predicate.
+ */
+gaya::eval::object::object
+takewhile(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence that drops elements from the input sequence as long as they
+ * satisfy the given predicate.
+ * @param xs <sequence> The sequence.
+ * @param pred <function> The predicate.
+ */
+gaya::eval::object::object
+dropwhile(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence that yields 2 element arrays where the first element is the
+ * index of the second element from the provided sequence.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+enumerate(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Create a new sequence that flattens one level of the provided sequence.
+ * @param xs <sequence> The sequence to flatten.
+ */
+gaya::eval::object::object
+flatten(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Map a function over the elements of the provided sequence and concatenate
+ * the resulting sequences.
+ * @param xs <sequence> The input sequence.
+ * @param func <function> The transformation function that should return a
+ *                        sequence.
+ */
+gaya::eval::object::object
+concat_map(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Call the provided function for each element in the sequence, discarding
+ * the results.
+ * @param xs <sequence> A sequence.
+ * @param func <function> A function to call on every element in the sequence.
+ */
+gaya::eval::object::object
+for_each(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Reduce the provided sequence according to the specified accumulator function,
+ * using the given initial element. Return the initial element if the sequence
+ * was empty.
+ * @param xs <sequence> A sequence.
+ * @param init <object> The initial element.
+ * @param func <function> The accumulator function.
+ */
+gaya::eval::object::object
+reduce(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the sum of the numbers in the provided sequence.
+ *
+ * This function consumes the provided sequence.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+sum(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of elements in a sequence.
+ *
+ * This function consumes the provided sequence.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+count(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a dictionary from the keys the provided function computes for the
+ * elements of a sequence to arrays of the elements with that key, in the order
+ * they come in.
+ * @param xs <sequence> The sequence.
+ * @param func <function> The function that computes the key of an element.
+ */
+gaya::eval::object::object
+group_by(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a dictionary from the keys the provided function computes for the
+ * elements of a sequence to the number of elements with that key.
+ * @param xs <sequence> The sequence.
+ * @param func <function> The function that computes the key of an element.
+ */
+gaya::eval::object::object
+count_by(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a dictionary from the distinct elements of a sequence to the number
+ * of times they occur in it.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+histogram(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over the elements of the provided one, skipping those
+ * equal to an element that came before.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+unique(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return whether any element in the provided sequence satisfies the given
+ * predicate.
+ * @param xs <sequence> The sequence.
+ * @param pred <function> The predicate.
+ */
+gaya::eval::object::object
+any(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return whether all the elements in the provided sequence satisfy the given
+ * predicate.
+ * @param xs <sequence> The sequence.
+ * @param pred <function> The predicate.
+ */
+gaya::eval::object::object
+all(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the least element in a sequence according to the '<' operator. If the
+ * sequence is empty, unit is returned.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+min(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the greatest element in a sequence according to the '>' operator. If
+ * the sequence is empty, unit is returned.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+max(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with the elements of the provided sequence.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+toarray(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over the initial segments of the provided sequence,
+ * shortest first.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+inits(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over the final segments of the provided sequence, longest
+ * first.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+tails(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array of n independent sequences over the elements of the
+ * provided one. Elements are pulled from it once and buffered until every
+ * sequence has seen them, so it should not be used directly afterwards.
+ * @param xs <sequence> The sequence.
+ * @param n <number> The number of sequences to return.
+ */
+gaya::eval::object::object
+tee(interpreter&, span, const std::vector<object>&) noexcept;
+
 }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <object.hpp>
+
+namespace gaya::eval::object::builtin::set
+{
+
+/**
+ * Return a set with the elements of the provided sequence. A set gives a copy
+ * of itself.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+make(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of elements in the provided set.
+ * @param s <set> The set.
+ */
+gaya::eval::object::object
+length(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Add an element to the provided set.
+ * This mutates the original set.
+ *
+ * @param s <set> The set.
+ * @param x <object> The element to add.
+ * @return The provided set.
+ */
+gaya::eval::object::object
+add(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Remove an element from the provided set, if it is there.
+ * This mutates the original set.
+ *
+ * @param s <set> The set.
+ * @param x <object> The element to remove.
+ * @return The provided set.
+ */
+gaya::eval::object::object
+remove(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return 1 if the element is in the set, unit otherwise.
+ * @param s <set> The set.
+ * @param x <object> The element.
+ */
+gaya::eval::object::object
+contains(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new set with the elements that are in either set.
+ * @param a <set> The first set.
+ * @param b <set> The second set.
+ */
+gaya::eval::object::object
+union_(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new set with the elements that are in both sets.
+ * @param a <set> The first set.
+ * @param b <set> The second set.
+ */
+gaya::eval::object::object
+intersection(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new set with the elements of the first set that are not in the
+ * second one.
+ * @param a <set> The first set.
+ * @param b <set> The second set.
+ */
+gaya::eval::object::object
+difference(interpreter&, span, const std::vector<object>&) noexcept;
+
+}
@@ -77,4 +77,54 @@ endswith(interpreter&, span, const std::vector<object>&) noexcept;
 gaya::eval::object::object
 trim(interpreter&, span, const std::vector<object>&) noexcept;
 
+/**
+ * Split a string on the given pattern and return a sequence over the parts.
+ * An empty pattern splits the string into its characters.
+ *
+ * @param s <string> The string to split.
+ * @param pattern <string> The pattern to split the string on.
+ */
+gaya::eval::object::object
+split(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Like string.split, but return an array instead of a sequence.
+ *
+ * @param s <string> The string to split.
+ * @param pattern <string> The pattern to split the string on.
+ */
+gaya::eval::object::object
+split_array(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a sequence over the lines in the provided string.
+ * @param s <string> The string to split.
+ */
+gaya::eval::object::object
+lines(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with every unsigned decimal number found in the string.
+ * Anything that is not part of a number, including '-', is a separator.
+ * @param s <string> The string to scan.
+ */
+gaya::eval::object::object
+numbers(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with every integer found in the string. A '-' right before
+ * a digit is taken as the sign of the integer.
+ * @param s <string> The string to scan.
+ */
+gaya::eval::object::object
+integers(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an array with one array per line, holding the integers found in that
+ * line as string.integers would.
+ * @param s <string> The string to scan.
+ */
+gaya::eval::object::object
+integer_lines(interpreter&, span, const std::vector<object>&) noexcept;
+
 }
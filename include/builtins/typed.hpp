@@ -0,0 +1,116 @@
+#pragma once
+
+#include <object.hpp>
+
+namespace gaya::eval::object::builtin::typed
+{
+
+/**
+ * Return a Float64Array with the numbers of the provided sequence.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+float64(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return an Int64Array with the numbers of the provided sequence, which must
+ * all be whole.
+ * @param xs <sequence> The sequence.
+ */
+gaya::eval::object::object
+int64(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the number of elements in the provided typed array.
+ * @param a <typed array> The array.
+ */
+gaya::eval::object::object
+length(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the sum of the numbers in the provided typed array.
+ * @param a <typed array> The array.
+ */
+gaya::eval::object::object
+sum(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the smallest number in the provided typed array, or unit if it is
+ * empty.
+ * @param a <typed array> The array.
+ */
+gaya::eval::object::object
+min(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the largest number in the provided typed array, or unit if it is
+ * empty.
+ * @param a <typed array> The array.
+ */
+gaya::eval::object::object
+max(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return the sum of the products of the numbers at the same index in two
+ * typed arrays of the same length.
+ * @param a <typed array> The first array.
+ * @param b <typed array> The second array.
+ */
+gaya::eval::object::object
+dot(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new typed array of the same kind whose numbers are the running
+ * totals of the provided one, or a Float64Array if a total overflows.
+ * @param a <typed array> The array.
+ */
+gaya::eval::object::object
+prefix_sum(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new typed array with the sums of the numbers at the same index in
+ * two typed arrays of the same length. The result is an Int64Array if both
+ * are and no sum overflows.
+ * @param a <typed array> The first array.
+ * @param b <typed array> The second array.
+ */
+gaya::eval::object::object
+add(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new typed array with the products of the numbers at the same index
+ * in two typed arrays of the same length. The result is an Int64Array if both
+ * are and no product overflows.
+ * @param a <typed array> The first array.
+ * @param b <typed array> The second array.
+ */
+gaya::eval::object::object
+mul(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a new typed array with the numbers of the provided one multiplied by
+ * a factor. The result is an Int64Array if the array is one, the factor is
+ * whole and no product overflows.
+ * @param a <typed array> The array.
+ * @param k <number> The factor.
+ */
+gaya::eval::object::object
+scale(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Sort the provided typed array in place, from the smallest number to the
+ * largest.
+ * @param a <typed array> The array.
+ * @return The provided array.
+ */
+gaya::eval::object::object
+sort(interpreter&, span, const std::vector<object>&) noexcept;
+
+/**
+ * Return a regular array with the numbers of the provided typed array.
+ * @param a <typed array> The array.
+ */
+gaya::eval::object::object
+to_array(interpreter&, span, const std::vector<object>&) noexcept;
+
+}
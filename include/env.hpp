@@ -75,9 +75,14 @@ public:
     explicit env(parent_ptr p = nullptr);
 
     /**
-     * Deep copy this environment.
+     * Copy this environment for a copy of a sequence, so that neither of them
+     * can observe the other advancing.
+     *
+     * Frames with locals, which can be assigned, or with sequences, which
+     * advance in place, are copied along with the frames below them. The rest
+     * of the chain is shared, since nothing can change through it.
      */
-    [[nodiscard]] env deep_copy(interpreter&, span) const noexcept;
+    [[nodiscard]] env fork(interpreter&, span) const noexcept;
 
     /// Set a binding in the environment.
     void set(key&&, value_type) noexcept;
@@ -111,6 +116,12 @@ public:
     [[nodiscard]] const parent_ptr parent() const noexcept;
 
 private:
+    [[nodiscard]] static parent_ptr
+    fork_chain(const parent_ptr&, interpreter&, span) noexcept;
+    [[nodiscard]] env
+    fork_frame(parent_ptr, interpreter&, span) const noexcept;
+    [[nodiscard]] bool can_change() const noexcept;
+
     [[nodiscard]] const env& nth_parent(size_t) const noexcept;
     [[nodiscard]] env& nth_parent(size_t) noexcept;
 
@@ -7,6 +7,7 @@
 #include <diagnostic.hpp>
 #include <env.hpp>
 #include <object.hpp>
+#include <output_buffer.hpp>
 #include <parser.hpp>
 #include <span.hpp>
 
@@ -15,6 +16,27 @@ namespace gaya::eval
 
 namespace fs = std::filesystem;
 
+class generator;
+
+/**
+ * The part of the interpreter's state that belongs to a suspended generator,
+ * which is the scopes it has pushed.
+ */
+struct execution_context
+{
+    std::vector<env> scopes;
+};
+
+/**
+ * Where the scopes of a generator begin on the interpreter's scope stack, and
+ * the generator that was running before it.
+ */
+struct execution_mark
+{
+    size_t scopes;
+    generator* running;
+};
+
 class interpreter final : public ast::ast_visitor
 {
 public:
@@ -68,11 +90,30 @@ public:
      */
     [[nodiscard]] const std::vector<env>& scopes() const noexcept;
 
+    /**
+     * Move the scopes of a generator onto the scope stack and make it the
+     * running one.
+     * @return The mark to suspend the generator at.
+     */
+    [[nodiscard]] execution_mark
+    resume_execution(generator&, execution_context&) noexcept;
+
+    /**
+     * Move the scopes above the mark into the context and give control back
+     * to the generator that was running before.
+     */
+    void suspend_execution(const execution_mark&, execution_context&) noexcept;
+
     /**
      * @return The parser that the interpreter uses.
      */
     [[nodiscard]] parser& get_parser() noexcept;
 
+    /**
+     * @return The buffer that standard output is written through.
+     */
+    [[nodiscard]] output_buffer& output() noexcept;
+
     /**
      * Execute a match pattern. Exposed for object::function::call.
      */
@@ -116,6 +157,8 @@ public:
     ResultType visit_lnot_expression(ast::lnot_expression&) override;
     ResultType visit_not_expression(ast::not_expression&) override;
     ResultType visit_perform_expression(ast::perform_expression&) override;
+    ResultType visit_generator_expression(ast::generator_expression&) override;
+    ResultType visit_yield_expression(ast::yield_expression&) override;
     ResultType visit_binary_expression(ast::binary_expression&) override;
     ResultType visit_add_numbers(ast::AddNumbers&) override;
     ResultType visit_less_than_numbers(ast::LessThanNumbers&) override;
@@ -137,10 +180,14 @@ private:
     parser _parser;
     std::vector<diagnostic::diagnostic> _diagnostics;
     std::vector<env> _scopes;
+    output_buffer _output;
 
     int _placeholders_in_use      = 0;
     bool _had_unused_placeholders = false;
 
+    /* The generator whose body is being run, if any. */
+    generator* _generator = nullptr;
+
     std::unordered_map<std::string, types::Type> _declared_types;
 
     char** _command_line_arguments;
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 namespace gaya
 {
@@ -9,15 +13,83 @@ class file_reader
 {
 public:
     file_reader(std::filesystem::path);
+    ~file_reader();
+
+    file_reader(const file_reader&)            = delete;
+    file_reader& operator=(const file_reader&) = delete;
 
     /// Dynamically allocated memory should be relased.
     [[nodiscard]] char* slurp() noexcept;
 
+    /// Map the file into memory. The contents stay valid until the reader is
+    /// destroyed.
+    [[nodiscard]] std::optional<std::string_view> map() noexcept;
+
     [[nodiscard]] operator bool() const noexcept;
 
 private:
     std::filesystem::path _path;
     bool _valid = true;
+
+    void* _mapping       = nullptr;
+    size_t _mapping_size = 0;
+};
+
+/// Read a file line by line through a fixed size buffer, so that arbitrarily
+/// large files can be processed without loading them in memory.
+class line_reader
+{
+public:
+    /// Open the file and position the reader at the given byte offset.
+    line_reader(std::filesystem::path, size_t offset = 0);
+
+    /// Read from an already open file descriptor, which is not closed by the
+    /// reader.
+    explicit line_reader(int fd);
+
+    ~line_reader();
+
+    line_reader(const line_reader&)            = delete;
+    line_reader& operator=(const line_reader&) = delete;
+
+    /// Return the next line without its newline, or an empty optional at the
+    /// end of the file. The line stays valid until the next call.
+    [[nodiscard]] std::optional<std::string_view> next() noexcept;
+
+    /// Return the bytes that are buffered but were not returned yet, reading
+    /// more if there are none, or an empty optional at the end of the file.
+    /// The chunk stays valid until the next call.
+    [[nodiscard]] std::optional<std::string_view> next_chunk() noexcept;
+
+    /// Return the offset in the file of the first byte that was not returned
+    /// yet.
+    [[nodiscard]] size_t offset() const noexcept;
+
+    /// Return the path of the file being read.
+    [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+    /// Whether the reader was opened from a path, and can thus be reopened at
+    /// its current offset.
+    [[nodiscard]] bool reopenable() const noexcept;
+
+    [[nodiscard]] operator bool() const noexcept;
+
+private:
+    /// Read more of the file into the buffer, returning false at the end.
+    [[nodiscard]] bool fill() noexcept;
+
+    std::filesystem::path _path;
+    int _fd       = -1;
+    bool _owns_fd = true;
+    std::vector<char> _buffer;
+    size_t _start = 0;
+    size_t _end   = 0;
+    /// The offset in the file of the start of the buffer.
+    size_t _buffer_offset = 0;
 };
 
+/// Return the reader shared by everything that reads from standard input, so
+/// that no input is lost in the buffer of another reader.
+[[nodiscard]] std::shared_ptr<line_reader> stdin_reader() noexcept;
+
 }
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+#include <env.hpp>
+#include <eval.hpp>
+#include <object.hpp>
+#include <span.hpp>
+
+namespace gaya::ast
+{
+struct expression;
+}
+
+namespace gaya::eval
+{
+
+/*
+ * Where a suspended flow of control resumes. On x86-64 that is just a stack
+ * pointer, since a switch pushes the registers it must keep on the stack it
+ * leaves.
+ */
+struct machine_context
+{
+#if defined(__x86_64__)
+    void* sp = nullptr;
+#else
+    ucontext_t registers;
+    char* low = nullptr;
+#endif
+};
+
+/*
+ * The state of a gen expression.
+ *
+ * The body runs on a stack of its own, so a yield can suspend it anywhere, with
+ * its scopes and the native frames of the interpreter left as they are, and the
+ * next element resumes it right where it stopped.
+ *
+ * All generators share one such stack. The frames of the one that ran last stay
+ * on it and the others keep theirs in a buffer until they run again, so a
+ * suspended generator only costs the few kilobytes its frames take up.
+ */
+class generator final
+{
+public:
+    generator(std::shared_ptr<ast::expression> body, env base) noexcept;
+    ~generator();
+
+    generator(const generator&)            = delete;
+    generator& operator=(const generator&) = delete;
+
+    /**
+     * Run the body up to its next yield.
+     * @return The yielded value, unit once the body has finished or invalid if
+     *         an error happened.
+     */
+    [[nodiscard]] object::object resume(interpreter&, span) noexcept;
+
+    /**
+     * Suspend the body, making the value the result of the resume that ran
+     * it. Only called by the body itself.
+     */
+    void yield(interpreter&, object::object) noexcept;
+
+    /// Whether the body has been run at all.
+    [[nodiscard]] bool started() const noexcept;
+
+    /// The body, for making a fresh generator over it.
+    [[nodiscard]] const std::shared_ptr<ast::expression>& body() const noexcept;
+
+    /// The scopes of the body while it is not running.
+    [[nodiscard]] const std::vector<env>& scopes() const noexcept;
+
+private:
+    enum class state {
+        created,
+        suspended,
+        running,
+        done,
+    };
+
+    static bool reserve_stack() noexcept;
+    static void transfer(
+        machine_context& from,
+        generator* from_owner,
+        machine_context& to,
+        generator* to_owner) noexcept;
+    static void save_occupant() noexcept;
+    static void switch_stacks() noexcept;
+    static void enter() noexcept;
+
+    void restore() noexcept;
+    void run() noexcept;
+
+    std::shared_ptr<ast::expression> _body;
+    execution_context _context;
+    execution_mark _mark { 0, nullptr };
+    state _state = state::created;
+
+    /* What the resume that is running the body gets back. */
+    interpreter* _interp  = nullptr;
+    span _span            = span::invalid;
+    object::object _value = object::invalid;
+
+    machine_context _own;
+    machine_context _caller;
+
+    /* The frames of the body, and where they go on the shared stack, while
+     * another generator has it. */
+    std::vector<char> _frames;
+    char* _frames_at = nullptr;
+};
+
+}
@@ -38,6 +38,7 @@ enum class token_type {
     equal,
     equal_equal,
     for_,
+    gen,
     given,
     greater_than,
     greater_than_eq,
@@ -73,6 +74,7 @@ enum class token_type {
     when,
     while_,
     xor_,
+    yield_,
     upto,
 };
 
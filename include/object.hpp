@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -9,6 +10,7 @@
 #include <nanbox.h>
 #include <robin_hood.h>
 
+#include <file_reader.hpp>
 #include <span.hpp>
 #include <types.hpp>
 
@@ -21,6 +23,14 @@
 #define IS_HEAP_OBJECT(o) (nanbox_is_pointer((o).box))
 #define IS_STRUCT(o)      ((o).type == gaya::eval::object::object_type_struct)
 #define IS_ENUM(o)        ((o).type == gaya::eval::object::object_type_enum)
+#define IS_TUPLE(o)       ((o).type == gaya::eval::object::object_type_tuple)
+#define IS_SET(o)         ((o).type == gaya::eval::object::object_type_set)
+#define IS_DEQUE(o)       ((o).type == gaya::eval::object::object_type_deque)
+#define IS_GRID(o)        ((o).type == gaya::eval::object::object_type_grid)
+#define IS_TYPED_ARRAY(o) \
+    ((o).type == gaya::eval::object::object_type_typed_array)
+#define IS_PRIORITY_QUEUE(o) \
+    ((o).type == gaya::eval::object::object_type_priority_queue)
 #define IS_DICTIONARY(o) \
     ((o).type == gaya::eval::object::object_type_dictionary)
 #define IS_BUILTIN_FUNCION(o) \
@@ -37,6 +47,12 @@
 #define AS_STRUCT(o)           AS_HEAP_OBJECT(o)->as_struct_object
 #define AS_ENUM(o)             AS_HEAP_OBJECT(o)->as_enum_object
 #define AS_SEQUENCE(o)         AS_HEAP_OBJECT(o)->as_sequence
+#define AS_TUPLE(o)            AS_HEAP_OBJECT(o)->as_tuple
+#define AS_SET(o)              AS_HEAP_OBJECT(o)->as_set
+#define AS_PRIORITY_QUEUE(o)   AS_HEAP_OBJECT(o)->as_priority_queue
+#define AS_DEQUE(o)            AS_HEAP_OBJECT(o)->as_deque
+#define AS_GRID(o)             AS_HEAP_OBJECT(o)->as_grid
+#define AS_TYPED_ARRAY(o)      AS_HEAP_OBJECT(o)->as_typed_array
 
 namespace gaya::ast
 {
@@ -49,6 +65,7 @@ namespace gaya::eval
 {
 class interpreter;
 class env;
+class generator;
 }
 
 namespace gaya::eval::object
@@ -66,6 +83,12 @@ enum object_type {
     object_type_sequence,
     object_type_struct,
     object_type_enum,
+    object_type_tuple,
+    object_type_set,
+    object_type_priority_queue,
+    object_type_deque,
+    object_type_grid,
+    object_type_typed_array,
 };
 
 struct object
@@ -195,10 +218,13 @@ struct string_sequence
     size_t index = 0;
 };
 
+/*
+ * A sequence over the elements of an array. Like a for loop, it reads them
+ * by index, so it sees elements pushed while it runs.
+ */
 struct array_sequence final
 {
-    /* TODO: Should we keep a copy of this? */
-    const std::vector<object>& elems;
+    object array;
     size_t index = 0;
 };
 
@@ -214,19 +240,262 @@ struct user_defined_sequence final
     object next_func;
 };
 
+enum dict_sequence_kind {
+    dict_sequence_items,
+    dict_sequence_keys,
+    dict_sequence_values,
+};
+
+/*
+ * A lazy cursor over the entries of a dictionary.
+ *
+ * The cursor walks the entries of the table by index, so iterating fails if
+ * keys are added to or removed from the dictionary in the meantime.
+ */
 struct dict_sequence final
 {
-    std::vector<object> keys;
-    std::vector<object> values;
+    object dict;
+    size_t index;
+    size_t changes;
+    dict_sequence_kind kind = dict_sequence_items;
+};
+
+/*
+ * A lazy cursor over the elements of a set, which like that of a dictionary
+ * fails if elements are added or removed in the meantime.
+ */
+struct set_sequence final
+{
+    object set;
+    size_t index;
+    size_t changes;
+};
+
+/*
+ * A lazy sequence over the parts of a string separated by a pattern.
+ *
+ * An empty separator yields the characters of the string.
+ */
+struct split_sequence final
+{
+    object string;
+    std::string separator;
+    size_t index = 0;
+    bool done    = false;
+};
+
+/*
+ * A sequence over the lines of a file, read through a bounded buffer.
+ */
+struct lines_sequence final
+{
+    std::shared_ptr<line_reader> reader;
+
+    /* Yield whatever bytes are buffered instead of lines. */
+    bool chunks = false;
+};
+
+/*
+ * Sequences that lazily transform the elements of another one, which is kept
+ * in `inner` as returned by to_sequence. Only the callbacks they are given
+ * are run by the interpreter.
+ */
+
+/*
+ * Map and filter read `inner` a batch at a time, running their callbacks in
+ * between, only when `batched` says nothing else can read it.
+ */
+struct map_sequence final
+{
+    object inner;
+    object func;
+    bool batched = false;
+};
+
+struct filter_sequence final
+{
+    object inner;
+    object pred;
+    bool batched = false;
+};
+
+struct take_sequence final
+{
+    object inner;
+    double remaining;
+};
+
+struct drop_sequence final
+{
+    object inner;
+    double remaining;
+};
+
+struct takewhile_sequence final
+{
+    object inner;
+    object pred;
+    bool done = false;
+};
+
+struct dropwhile_sequence final
+{
+    object inner;
+    object pred;
+    bool dropping = true;
+};
+
+struct enumerate_sequence final
+{
+    object inner;
+    double index = 0;
+};
+
+/*
+ * Yields the elements of `inner` that it has not yielded before, remembering
+ * each of them in `seen`.
+ */
+struct unique_sequence final
+{
+    object inner;
+    robin_hood::unordered_set<object> seen;
+};
+
+/*
+ * Yields the elements of each of the sequences yielded by `inner` in turn.
+ * `current` is unit until the first of them is needed.
+ */
+struct flatten_sequence final
+{
+    object inner;
+    object current;
+};
+
+/*
+ * The elements of a sequence shared by the cursors seq.tee makes over it.
+ *
+ * Elements are kept in a ring buffer from the one the slowest cursor reads
+ * next up to the last one pulled from the source, so the buffer only grows as
+ * far as the cursors drift apart.
+ *
+ * Cursors are never removed, since heap objects are freed without running
+ * their destructors. A cursor that is dropped before reaching the end thus
+ * stays the slowest for good, and everything after it stays buffered.
+ */
+class tee_buffer final
+{
+public:
+    explicit tee_buffer(object source) noexcept;
+
+    /**
+     * Add a cursor at the given position, counted from the first element of
+     * the source, and return its id.
+     */
+    [[nodiscard]] size_t add_cursor(size_t position) noexcept;
+
+    /**
+     * Return the next element for a cursor, unit at the end of the source or
+     * invalid if an error happened.
+     */
+    [[nodiscard]] object next(interpreter&, span, size_t cursor) noexcept;
+
+    [[nodiscard]] size_t position(size_t cursor) const noexcept;
+    [[nodiscard]] const object& source() const noexcept;
+    [[nodiscard]] const std::vector<object>& buffered() const noexcept;
+
+private:
+    void push(object) noexcept;
+    void trim() noexcept;
+
+    object _source;
+    std::vector<object> _ring;
+    std::vector<size_t> _cursors;
+
+    /* The ring index and source position of the oldest buffered element. */
+    size_t _head  = 0;
+    size_t _first = 0;
+    size_t _count = 0;
+    bool _done    = false;
+};
+
+struct tee_sequence final
+{
+    std::shared_ptr<tee_buffer> buffer;
+    size_t cursor;
+};
+
+/*
+ * Yields the prefixes of an array, shortest first, or its suffixes, longest
+ * first, as sequences over the array itself.
+ */
+struct segments_sequence final
+{
+    object elems;
+    size_t length;
+    bool suffixes;
     size_t i = 0;
 };
 
+/*
+ * A sequence over the elements of a tuple.
+ */
+struct tuple_sequence final
+{
+    object tuple;
+    size_t index = 0;
+};
+
+/*
+ * A sequence over the elements of a deque, which like that of an array reads
+ * them by index, so it sees elements added at the back while it runs.
+ */
+struct deque_sequence final
+{
+    object deque;
+    size_t index = 0;
+};
+
+/*
+ * A sequence over the numbers of a typed array.
+ */
+struct typed_array_sequence final
+{
+    object array;
+    size_t index = 0;
+};
+
+/*
+ * The values a gen expression yields, computed by resuming its body.
+ */
+struct generator_sequence final
+{
+    std::shared_ptr<generator> state;
+};
+
 enum sequence_type {
     sequence_type_string,
     sequence_type_array,
     sequence_type_number,
     sequence_type_user,
     sequence_type_dict,
+    sequence_type_split,
+    sequence_type_lines,
+    sequence_type_map,
+    sequence_type_filter,
+    sequence_type_take,
+    sequence_type_drop,
+    sequence_type_takewhile,
+    sequence_type_dropwhile,
+    sequence_type_enumerate,
+    sequence_type_flatten,
+    sequence_type_segments,
+    sequence_type_tee,
+    sequence_type_generator,
+    sequence_type_unique,
+    sequence_type_tuple,
+    sequence_type_set,
+    sequence_type_deque,
+    sequence_type_typed_array,
 };
 
 struct sequence
@@ -238,7 +507,25 @@ struct sequence
         array_sequence,
         number_sequence,
         user_defined_sequence,
-        dict_sequence>
+        dict_sequence,
+        split_sequence,
+        lines_sequence,
+        map_sequence,
+        filter_sequence,
+        take_sequence,
+        drop_sequence,
+        takewhile_sequence,
+        dropwhile_sequence,
+        enumerate_sequence,
+        flatten_sequence,
+        segments_sequence,
+        tee_sequence,
+        generator_sequence,
+        unique_sequence,
+        tuple_sequence,
+        set_sequence,
+        deque_sequence,
+        typed_array_sequence>
         seq;
 };
 
@@ -248,18 +535,607 @@ struct sequence
 [[nodiscard]] object
 copy_sequence(interpreter&, span, const sequence&) noexcept;
 
+/*
+ * The containers below keep the nanboxes of their elements but not their
+ * spans. Each is created with the span of the expression that made it, and
+ * every element read back from it gets that span.
+ */
+
+/*
+ * The elements of an array, kept as their nanboxes along with the one type
+ * they all share, so that an array of numbers is a buffer of doubles and one
+ * of strings a buffer of pointers.
+ *
+ * The first element of another type widens the array, which from then on
+ * keeps the type of each element next to its nanbox.
+ *
+ * Copies and slices share the buffer of the array they come from, and each
+ * is a window into it. Whichever changes first copies its window out, so
+ * the others never see the change.
+ */
+class packed_array final
+{
+public:
+    /**
+     * Create an empty array.
+     */
+    explicit packed_array(span) noexcept;
+    packed_array(span, const std::vector<object>& elems) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * The elements from start up to but not including end, sharing this
+     * array's buffer. Both must be in range and start must not be past end.
+     */
+    [[nodiscard]] packed_array slice(size_t start, size_t end) const noexcept;
+
+    /// The element at an index, which must be in range.
+    [[nodiscard]] object operator[](size_t index) const noexcept;
+    void set(size_t index, const object&) noexcept;
+
+    void push_back(const object&) noexcept;
+    void append(const packed_array&) noexcept;
+
+    /// Remove the last element. The array must not be empty.
+    void pop_back() noexcept;
+
+    /// The type of every element, or nothing if they have different types.
+    [[nodiscard]] std::optional<object_type> kind() const noexcept;
+
+    /**
+     * The nanbox of the element at an index, for walking arrays whose
+     * elements all have the same type without making an object for each.
+     */
+    [[nodiscard]] nanbox_t box(size_t index) const noexcept;
+
+    [[nodiscard]] std::vector<object> to_vector() const noexcept;
+
+private:
+    struct buffer
+    {
+        std::vector<nanbox_t> boxes;
+        std::vector<unsigned char> types;
+    };
+
+    void own() noexcept;
+    void widen() noexcept;
+
+    std::shared_ptr<buffer> _buffer;
+    size_t _offset    = 0;
+    size_t _size      = 0;
+    object_type _kind = object_type_invalid;
+    bool _mixed       = false;
+    class span _span;
+};
+
+/*
+ * An array that cannot change once made.
+ *
+ * Its hash is computed when it is made, and it is the same as that of an array
+ * with equal elements, which it also compares equal to. Up to inline_capacity
+ * elements are kept in the tuple itself, as their types and nanboxes, and
+ * longer tuples keep them in a buffer of their own.
+ */
+class tuple final
+{
+public:
+    static constexpr size_t inline_capacity = 6;
+
+    /**
+     * Make a tuple of the given elements.
+     */
+    tuple(span, const std::vector<object>& elems) noexcept;
+    tuple(span, const packed_array& elems) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] object operator[](size_t index) const noexcept;
+    [[nodiscard]] size_t hash() const noexcept;
+
+private:
+    struct element
+    {
+        nanbox_t box;
+        object_type type;
+    };
+
+    [[nodiscard]] const element* elements() const noexcept;
+
+    template <typename Elements>
+    void fill(const Elements&) noexcept;
+
+    size_t _hash;
+    size_t _size;
+    class span _span;
+    std::array<element, inline_capacity> _inline;
+    std::vector<element> _spilled;
+};
+
+/*
+ * An entry of a dictionary, kept as the types and nanboxes of its key and
+ * value.
+ */
+struct dictionary_entry
+{
+    nanbox_t key;
+    nanbox_t value;
+    object_type key_type;
+    object_type value_type;
+};
+
+/*
+ * An entry of a set, which is only a key.
+ */
+struct set_entry
+{
+    nanbox_t key;
+    object_type key_type;
+};
+
+/*
+ * A hash table of objects, which dictionaries and sets are made of.
+ *
+ * Entries are kept in the order they were added, in an array of their types
+ * and nanboxes, and the table itself only holds their indices, so a probe
+ * looks at 8 bytes per slot. Removing an entry leaves a hole in the array
+ * until the table is rebuilt.
+ *
+ * While the keys are all numbers, or all strings, they are hashed and compared
+ * by their bits, which for strings is their address since strings are
+ * interned. The first key of another type switches the table to object::hash
+ * and object::equals for good.
+ *
+ * Array keys are stored as tuples, so that changing the array afterwards does
+ * not leave its entry where a lookup would not find it.
+ *
+ * Copies of a table share its entries and slots until one of them changes,
+ * which then copies them for itself.
+ */
+template <typename Entry>
+class hash_table
+{
+public:
+    /**
+     * Create an empty table.
+     */
+    explicit hash_table(span) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Return the index of the entry for a key, if there is one.
+     *
+     * Indices stay valid until a key is added or removed, which changes the
+     * number returned by changes().
+     */
+    [[nodiscard]] std::optional<size_t> find(const object& key) const noexcept;
+    [[nodiscard]] bool contains(const object& key) const noexcept;
+
+    /// Remove the entry at an index.
+    void erase(size_t index) noexcept;
+
+    [[nodiscard]] object key(size_t index) const noexcept;
+
+    /// The number of times keys were added or removed.
+    [[nodiscard]] size_t changes() const noexcept;
+
+    /**
+     * Return the first index at or after the given one that holds an entry,
+     * or end_index() if there are none.
+     */
+    [[nodiscard]] size_t next_index(size_t index) const noexcept;
+    [[nodiscard]] size_t end_index() const noexcept;
+
+protected:
+    /**
+     * Return the index of the entry for a key, adding one that only has its
+     * key set if there is none, and whether it was added.
+     */
+    std::pair<size_t, bool>
+    emplace_key(interpreter&, const object& key) noexcept;
+
+    [[nodiscard]] const std::vector<Entry>& entries() const noexcept;
+
+    /// The entries, copied first if another table shares them.
+    [[nodiscard]] std::vector<Entry>& own_entries() noexcept;
+
+    class span _span;
+
+private:
+    enum class key_mode : unsigned char {
+        none,
+        numbers,
+        strings,
+        any,
+    };
+
+    struct slot
+    {
+        uint32_t index;
+        uint32_t tag;
+    };
+
+    struct storage
+    {
+        std::vector<Entry> entries;
+        std::vector<slot> slots;
+    };
+
+    [[nodiscard]] const storage& table() const noexcept;
+    [[nodiscard]] storage& own() noexcept;
+
+    [[nodiscard]] static key_mode mode_of(const object& key) noexcept;
+    [[nodiscard]] uint64_t hash_of(const object& key) const noexcept;
+    [[nodiscard]] bool same(const Entry&, const object& key) const noexcept;
+    [[nodiscard]] size_t probe(const object& key, uint64_t hash) const noexcept;
+    [[nodiscard]] size_t vacancy(uint64_t hash) const noexcept;
+    void admit(const object& key) noexcept;
+    void rebuild(size_t capacity) noexcept;
+
+    std::shared_ptr<storage> _storage;
+    size_t _size    = 0;
+    size_t _changes = 0;
+    key_mode _mode  = key_mode::none;
+};
+
+extern template class hash_table<dictionary_entry>;
+extern template class hash_table<set_entry>;
+
+/*
+ * A hash table from objects to objects.
+ */
+class dictionary final : public hash_table<dictionary_entry>
+{
+public:
+    class const_iterator final
+    {
+    public:
+        const_iterator(const dictionary& dict, size_t index) noexcept
+            : _dict { &dict }
+            , _index { dict.next_index(index) }
+        {
+        }
+
+        [[nodiscard]] std::pair<object, object> operator*() const noexcept
+        {
+            return { _dict->key(_index), _dict->value(_index) };
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            _index = _dict->next_index(_index + 1);
+            return *this;
+        }
+
+        [[nodiscard]] bool
+        operator==(const const_iterator& other) const noexcept
+        {
+            return _index == other._index;
+        }
+
+    private:
+        const dictionary* _dict;
+        size_t _index;
+    };
+
+    using hash_table::hash_table;
+
+    /**
+     * Return the index of the entry for a key, adding one with the given value
+     * if there is none, and whether it was added.
+     */
+    std::pair<size_t, bool> try_emplace(
+        interpreter&,
+        const object& key,
+        const object& value) noexcept;
+
+    void insert_or_assign(
+        interpreter&,
+        const object& key,
+        const object& value) noexcept;
+
+    [[nodiscard]] object value(size_t index) const noexcept;
+    void set_value(size_t index, const object& value) noexcept;
+
+    [[nodiscard]] const_iterator begin() const noexcept;
+    [[nodiscard]] const_iterator end() const noexcept;
+};
+
+/*
+ * A set of objects, which takes half the memory of a dictionary with the same
+ * keys.
+ */
+class hash_set final : public hash_table<set_entry>
+{
+public:
+    class const_iterator final
+    {
+    public:
+        const_iterator(const hash_set& set, size_t index) noexcept
+            : _set { &set }
+            , _index { set.next_index(index) }
+        {
+        }
+
+        [[nodiscard]] object operator*() const noexcept
+        {
+            return _set->key(_index);
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            _index = _set->next_index(_index + 1);
+            return *this;
+        }
+
+        [[nodiscard]] bool
+        operator==(const const_iterator& other) const noexcept
+        {
+            return _index == other._index;
+        }
+
+    private:
+        const hash_set* _set;
+        size_t _index;
+    };
+
+    using hash_table::hash_table;
+
+    /// Add a key, returning whether it was not there yet.
+    bool insert(interpreter&, const object& key) noexcept;
+
+    /// Remove a key, returning whether it was there.
+    bool remove(const object& key) noexcept;
+
+    [[nodiscard]] const_iterator begin() const noexcept;
+    [[nodiscard]] const_iterator end() const noexcept;
+};
+
+/*
+ * A double-ended queue, kept in a ring buffer whose capacity is a power of two.
+ *
+ * The buffer doubles when it is full and halves when it is a quarter full, so
+ * a queue that is pushed at one end and popped at the other keeps to the
+ * memory its largest size needs, however many elements pass through it.
+ */
+class ring_buffer final
+{
+public:
+    /**
+     * Create an empty queue.
+     */
+    explicit ring_buffer(span) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    void push_front(const object&) noexcept;
+    void push_back(const object&) noexcept;
+
+    /**
+     * Remove and return the first or the last element. The queue must not be
+     * empty.
+     */
+    object pop_front() noexcept;
+    object pop_back() noexcept;
+
+    /// The element at an index from the front, which must be in range.
+    [[nodiscard]] object operator[](size_t index) const noexcept;
+
+private:
+    struct element
+    {
+        nanbox_t box;
+        object_type type;
+    };
+
+    [[nodiscard]] size_t slot(size_t index) const noexcept;
+    void resize(size_t capacity) noexcept;
+    void shrink() noexcept;
+
+    std::vector<element> _elements;
+    size_t _head = 0;
+    size_t _size = 0;
+    class span _span;
+};
+
+/*
+ * A rectangular grid of cells, kept row after row in a single buffer. Cells are
+ * addressed by their column x and their row y, both from zero.
+ */
+class dense_grid final
+{
+public:
+    /**
+     * Create a grid with every cell set to the given value.
+     */
+    dense_grid(span, size_t width, size_t height, const object& fill) noexcept;
+
+    /**
+     * Make a grid with a cell for each character of the lines of a text, in
+     * one pass over it. Trailing newlines are ignored.
+     * @return The grid, or nothing if the lines are not all the same length.
+     */
+    [[nodiscard]] static std::optional<dense_grid>
+    from_string(interpreter&, span, std::string_view) noexcept;
+
+    [[nodiscard]] size_t width() const noexcept;
+    [[nodiscard]] size_t height() const noexcept;
+    [[nodiscard]] size_t size() const noexcept;
+
+    /// Whether a point with the given coordinates is a cell of the grid, which
+    /// needs them to be whole numbers.
+    [[nodiscard]] bool contains(double x, double y) const noexcept;
+
+    /// The cell at a point, which must lie on the grid.
+    [[nodiscard]] object at(size_t x, size_t y) const noexcept;
+    void set(size_t x, size_t y, const object&) noexcept;
+
+    /// The cell at an index into the rows laid end to end.
+    [[nodiscard]] object operator[](size_t index) const noexcept;
+
+private:
+    struct element
+    {
+        nanbox_t box;
+        object_type type;
+    };
+
+    std::vector<element> _cells;
+    size_t _width;
+    size_t _height;
+    class span _span;
+};
+
+/*
+ * An array of numbers of a single kind, kept unboxed and next to each other so
+ * that whole-array operations can work on several of them at a time.
+ *
+ * Int64 arrays hold whole numbers exactly. They are read back as numbers like
+ * any other, so values beyond 2^53 lose precision once they leave the array.
+ */
+class typed_array final
+{
+public:
+    enum class kind {
+        float64,
+        int64,
+    };
+
+    /**
+     * Create an empty array.
+     */
+    typed_array(span, kind) noexcept;
+
+    [[nodiscard]] kind element_kind() const noexcept;
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// The number at an index, which must be in range.
+    [[nodiscard]] double at(size_t index) const noexcept;
+    [[nodiscard]] object operator[](size_t index) const noexcept;
+
+    /// Append a number, which must be whole if this is an int64 array.
+    void push_back(double) noexcept;
+
+    /**
+     * The storage of a float64 or of an int64 array. Only the one that
+     * matches the kind of the array is used.
+     */
+    [[nodiscard]] std::vector<double>& float64s() noexcept;
+    [[nodiscard]] const std::vector<double>& float64s() const noexcept;
+    [[nodiscard]] std::vector<int64_t>& int64s() noexcept;
+    [[nodiscard]] const std::vector<int64_t>& int64s() const noexcept;
+
+private:
+    std::vector<double> _float64s;
+    std::vector<int64_t> _int64s;
+    kind _kind;
+    class span _span;
+};
+
+/*
+ * A queue of values ordered by numeric priorities, lowest first, where values
+ * with the same priority come out in the order they went in.
+ *
+ * It is a 4-ary heap of priorities and slot indices, so the children a step
+ * down looks at share a cache line and the heap is half as deep as a binary
+ * one. The values sit apart in slots, along with where their entry is in the
+ * heap, so moving an entry up or down the heap moves 24 bytes.
+ */
+class priority_queue final
+{
+public:
+    static constexpr size_t arity = 4;
+
+    /**
+     * Create an empty queue.
+     */
+    explicit priority_queue(span) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Add a value, returning a handle that refers to it for as long as it is
+     * in the queue. Once it is popped, the handle refers to nothing, even
+     * when a later value takes its slot.
+     */
+    size_t push(double priority, const object& value) noexcept;
+
+    /// The value with the lowest priority. The queue must not be empty.
+    [[nodiscard]] object top() const noexcept;
+    [[nodiscard]] double top_priority() const noexcept;
+
+    /// Remove the value with the lowest priority.
+    void pop() noexcept;
+
+    /**
+     * Lower the priority of the value a handle refers to, returning false if
+     * it is no longer in the queue or its priority is not higher.
+     */
+    bool decrease(size_t handle, double priority) noexcept;
+
+    /// Whether a number is a handle push returned, queued or not.
+    [[nodiscard]] bool valid_handle(double handle) const noexcept;
+
+    /// The value at a position in the heap, for visiting all of them.
+    [[nodiscard]] object operator[](size_t position) const noexcept;
+
+private:
+    struct node
+    {
+        double priority;
+        uint64_t order;
+        uint32_t slot;
+    };
+
+    /*
+     * Where a value lives while it is queued. Popping a value frees its slot
+     * for a later push and bumps the generation, which handles carry so the
+     * ones to a freed slot stop referring to it.
+     */
+    struct slot
+    {
+        nanbox_t value;
+        object_type type;
+        uint32_t position;
+        uint32_t generation;
+    };
+
+    [[nodiscard]] static bool before(const node&, const node&) noexcept;
+    void place(size_t position, const node&) noexcept;
+    void sift_up(size_t position, node) noexcept;
+    void sift_down(size_t position, node) noexcept;
+
+    std::vector<node> _heap;
+    std::vector<slot> _slots;
+    std::vector<uint32_t> _free_slots;
+    uint64_t _pushes = 0;
+    class span _span;
+};
+
 struct heap_object
 {
     object_type type;
     union {
-        std::vector<object> as_array;
-        robin_hood::unordered_map<object, object> as_dictionary;
+        packed_array as_array;
+        dictionary as_dictionary;
         std::string as_string;
         function as_function;
         builtin_function as_builtin_function;
         sequence as_sequence;
         StructObject as_struct_object;
         EnumObject as_enum_object;
+        tuple as_tuple;
+        hash_set as_set;
+        priority_queue as_priority_queue;
+        ring_buffer as_deque;
+        dense_grid as_grid;
+        typed_array as_typed_array;
     };
     unsigned char marked     = 0;
     struct heap_object* next = nullptr;
@@ -292,14 +1168,54 @@ create_string(interpreter&, span, const std::string_view&) noexcept;
  */
 [[nodiscard]] object
 create_array(interpreter&, span, const std::vector<object>&) noexcept;
+[[nodiscard]] object create_array(interpreter&, span, packed_array) noexcept;
+
+/**
+ * Create a tuple object.
+ */
+[[nodiscard]] object
+create_tuple(interpreter&, span, const std::vector<object>&) noexcept;
+[[nodiscard]] object
+create_tuple(interpreter&, span, const packed_array&) noexcept;
+
+/**
+ * Create a deque object.
+ */
+[[nodiscard]] object create_deque(interpreter&, span, ring_buffer) noexcept;
+
+/**
+ * Create a grid object.
+ */
+[[nodiscard]] object create_grid(interpreter&, span, dense_grid) noexcept;
+
+/**
+ * Create a typed array object.
+ */
+[[nodiscard]] object
+create_typed_array(interpreter&, span, typed_array) noexcept;
+
+/**
+ * Create a priority queue object.
+ */
+[[nodiscard]] object
+create_priority_queue(interpreter&, span, priority_queue) noexcept;
+
+/**
+ * Create a set object.
+ */
+[[nodiscard]] object create_set(interpreter&, span, hash_set) noexcept;
+
+/**
+ * Create a sequence over the elements of a set.
+ */
+[[nodiscard]] object
+create_set_sequence(interpreter&, span, object set) noexcept;
 
 /**
  * Create a dictionary object.
  */
-[[nodiscard]] object create_dictionary(
-    interpreter&,
-    span,
-    const robin_hood::unordered_map<object, object>&) noexcept;
+[[nodiscard]] object
+create_dictionary(interpreter&, span, dictionary) noexcept;
 
 /**
  * Create a function object.
@@ -338,10 +1254,10 @@ create_array(interpreter&, span, const std::vector<object>&) noexcept;
     const std::string&);
 
 /**
- * Create an array sequence object.
+ * Create a sequence over the elements of an array object.
  */
 [[nodiscard]] object
-create_array_sequence(interpreter&, span, const std::vector<object>&) noexcept;
+create_array_sequence(interpreter&, span, const object& array) noexcept;
 
 /**
  * Create a string sequence object.
@@ -361,20 +1277,71 @@ create_number_sequence(interpreter&, span, double, double start = 0) noexcept;
 [[nodiscard]] object create_user_sequence(span, interpreter&, object) noexcept;
 
 /**
- * Create a dictionary sequence.
+ * Create a sequence over the entries, keys or values of a dictionary.
  */
 [[nodiscard]] object create_dict_sequence(
     interpreter&,
     span,
-    const robin_hood::unordered_map<object, object>&) noexcept;
+    object dict,
+    dict_sequence_kind = dict_sequence_items) noexcept;
+
+/**
+ * Create a sequence over the parts of a string split by the given separator.
+ */
+[[nodiscard]] object create_split_sequence(
+    interpreter&,
+    span,
+    object string,
+    const std::string& separator) noexcept;
+
+/**
+ * Create a sequence over the lines of the file at the given path, starting at
+ * the given byte offset.
+ */
+[[nodiscard]] object create_lines_sequence(
+    interpreter&,
+    span,
+    const std::filesystem::path&,
+    size_t offset = 0) noexcept;
+
+/**
+ * Create a sequence over the lines, or the chunks of bytes, produced by the
+ * given reader.
+ */
+[[nodiscard]] object create_lines_sequence(
+    interpreter&,
+    span,
+    std::shared_ptr<line_reader>,
+    bool chunks = false) noexcept;
+
+/**
+ * Create a sequence object from the given sequence.
+ */
+[[nodiscard]] object create_sequence(interpreter&, sequence) noexcept;
 
 /* Operations */
 
+/**
+ * Return the position of the first occurrence of the separator in s at or after
+ * pos, or std::string_view::npos if there is none.
+ *
+ * Single byte separators are located with memchr, longer ones with memmem.
+ */
+[[nodiscard]] size_t find_separator(
+    std::string_view s,
+    std::string_view separator,
+    size_t pos) noexcept;
+
 /**
  * Convert the provided object to a string representation.
  */
 [[nodiscard]] std::string to_string(interpreter&, object) noexcept;
 
+/**
+ * Append the string representation of the provided object to out.
+ */
+void to_string(interpreter&, object, std::string& out) noexcept;
+
 /**
  * Return a string representing the type of the object.
  */
@@ -405,6 +1372,15 @@ create_number_sequence(interpreter&, span, double, double start = 0) noexcept;
  */
 [[nodiscard]] size_t hash(const object&) noexcept;
 
+/**
+ * Mix the hash of an element into the hash of the ones before it, the way
+ * arrays and tuples are hashed.
+ */
+[[nodiscard]] constexpr size_t hash_combine(size_t seed, size_t hash) noexcept
+{
+    return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
 /**
  * Return whether the given object is callable or not.
  */
@@ -415,6 +1391,12 @@ create_number_sequence(interpreter&, span, double, double start = 0) noexcept;
  */
 [[nodiscard]] size_t arity(const object&) noexcept;
 
+/**
+ * Return whether a callable can be called with the given number of arguments,
+ * with default values for the parameters left out.
+ */
+[[nodiscard]] bool accepts(const object&, size_t nargs) noexcept;
+
 /**
  * For callables, invoke the callable.
  */
@@ -437,4 +1419,115 @@ call(object&, interpreter&, span, const std::vector<object>&) noexcept;
  */
 [[nodiscard]] object next(interpreter&, sequence&) noexcept;
 
+/**
+ * Return the next element of an object returned by to_sequence, which is unit
+ * for empty sequences.
+ */
+[[nodiscard]] object next(interpreter&, span, object&) noexcept;
+
+/**
+ * The number of elements consumers of whole sequences ask next_batch for.
+ */
+constexpr size_t sequence_batch_size = 128;
+
+/**
+ * Write up to n elements of the sequence to out and return how many were
+ * written. Fewer than n elements are written only when the sequence ends or
+ * an error happens, in which case the last element written is invalid.
+ */
+[[nodiscard]] size_t
+next_batch(interpreter&, sequence&, object* out, size_t n) noexcept;
+
+/**
+ * Like next_batch, for an object returned by to_sequence.
+ */
+[[nodiscard]] size_t
+next_batch(interpreter&, object&, object* out, size_t n) noexcept;
+
+/**
+ * Return whether elements can be pulled from the sequence ahead of when they
+ * are needed without any observable difference. That is the case when doing
+ * so runs no user code and the elements don't depend on mutable state, so
+ * code running between two calls to next cannot change what they would be.
+ */
+[[nodiscard]] bool can_prefetch(const sequence&) noexcept;
+[[nodiscard]] bool can_prefetch(const object&) noexcept;
+
+/**
+ * Return whether a consumer that runs user code between elements, or that may
+ * stop before the end, can read ahead of what it uses from xs, the result of
+ * calling to_sequence on the given object. Only sequences the consumer made
+ * itself can be, since a sequence it was given may be read again by anyone.
+ */
+[[nodiscard]] bool
+can_read_ahead(const object& given, const object& xs) noexcept;
+
+/*
+ * Sequences may advertise capabilities that let consumers avoid pulling their
+ * elements one by one. Adaptors have the ones of the sequences they read from
+ * when they can keep them without skipping any of their callbacks, except that
+ * seq.map keeps the size of its input.
+ */
+
+/**
+ * Return the number of elements left in the sequence if it is known without
+ * pulling them.
+ */
+[[nodiscard]] std::optional<size_t> exact_size(const sequence&) noexcept;
+[[nodiscard]] std::optional<size_t> exact_size(const object&) noexcept;
+
+/**
+ * Advance the sequence past up to n elements in constant time.
+ * @return The number of elements skipped, which is less than n only at the end
+ *         of the sequence, or an empty optional if the sequence can't skip
+ *         elements, in which case it is left untouched.
+ */
+[[nodiscard]] std::optional<size_t> skip(sequence&, size_t n) noexcept;
+[[nodiscard]] std::optional<size_t> skip(object&, size_t n) noexcept;
+
+/**
+ * Return the element n positions past the next one without advancing the
+ * sequence, unit if there is no such element, or an empty optional if the
+ * sequence is not indexable.
+ */
+[[nodiscard]] std::optional<object>
+element_at(interpreter&, const sequence&, size_t n) noexcept;
+[[nodiscard]] std::optional<object>
+element_at(interpreter&, span, const object&, size_t n) noexcept;
+
+/**
+ * Read the elements of an object returned by to_sequence one at a time,
+ * fetching them from the sequence in batches if asked to.
+ */
+class sequence_reader final
+{
+public:
+    sequence_reader(interpreter&, span, object xs, bool batched) noexcept;
+
+    /**
+     * Return the next element, unit at the end of the sequence or invalid if
+     * an error happened.
+     */
+    [[nodiscard]] object next() noexcept
+    {
+        if (_index < _count)
+        {
+            return _batch[_index++];
+        }
+
+        return refill();
+    }
+
+private:
+    [[nodiscard]] object refill() noexcept;
+
+    interpreter& _interp;
+    span _span;
+    object _xs;
+    bool _batched;
+    std::vector<object> _batch;
+    size_t _index = 0;
+    size_t _count = 0;
+};
+
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+namespace gaya
+{
+
+/// Accumulate output in memory and hand it to the operating system in large
+/// writes, instead of issuing a system call for every print.
+class output_buffer
+{
+public:
+    static constexpr size_t default_capacity = 64 * 1024;
+
+    explicit output_buffer(
+        int fd          = STDOUT_FILENO,
+        size_t capacity = default_capacity) noexcept;
+
+    /// Pending output is flushed on destruction.
+    ~output_buffer();
+
+    output_buffer(const output_buffer&)            = delete;
+    output_buffer& operator=(const output_buffer&) = delete;
+
+    /// Append some text, flushing if the buffer is full.
+    void write(std::string_view) noexcept;
+
+    /// Append a single character, flushing if the buffer is full.
+    void put(char) noexcept;
+
+    /// Access the pending output to format into it directly. Call commit()
+    /// once done, so that the buffer is flushed if it grew past its capacity.
+    [[nodiscard]] std::string& pending() noexcept;
+
+    /// Flush the buffer if it holds more than its capacity.
+    void commit() noexcept;
+
+    /// Write all pending output.
+    void flush() noexcept;
+
+    /// Change the capacity of the buffer. A capacity of 0 makes every write go
+    /// straight to the file descriptor.
+    void set_capacity(size_t) noexcept;
+
+    [[nodiscard]] size_t capacity() const noexcept;
+
+private:
+    int _fd;
+    size_t _capacity;
+    std::string _buffer;
+};
+
+}
@@ -88,6 +88,8 @@ private:
         std::shared_ptr<ast::identifier>                    = nullptr) noexcept;
     [[nodiscard]] ast::expression_ptr match_expression(token target);
     [[nodiscard]] ast::expression_ptr do_expression(token token);
+    [[nodiscard]] ast::expression_ptr generator_expression(token gen);
+    [[nodiscard]] ast::expression_ptr yield_expression(token yield);
 
     [[nodiscard]] ast::expression_ptr logical_expression(token) noexcept;
     [[nodiscard]] ast::expression_ptr comparison_expression(token) noexcept;
@@ -150,6 +152,9 @@ private:
 
     std::vector<scope> _scopes;
 
+    /* Whether a yield would belong to an enclosing generator. */
+    bool _in_generator = false;
+
     std::string _filename;
 
     std::unordered_set<std::string> _included_files;
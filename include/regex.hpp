@@ -0,0 +1,105 @@
+#pragma once
+
+#include <bitset>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace gaya::regex
+{
+
+/*
+ * A small regular expression engine.
+ *
+ * Patterns are compiled to a program for a Pike VM, which simulates the NFA
+ * for all threads in lockstep. Matching is linear in the length of the input
+ * and no pattern can make it backtrack.
+ *
+ * Supported syntax: literals, '.', character classes ([a-z], [^0-9]), the
+ * escapes \d \w \s \D \W \S \b \n \t \r, anchors '^' and '$', groups '(...)',
+ * non-capturing groups '(?:...)', alternation '|' and the quantifiers '*', '+',
+ * '?', '{n}', '{n,}' and '{n,m}', optionally followed by '?' to make them lazy.
+ */
+
+enum class opcode {
+    character,
+    char_class,
+    split,
+    jump,
+    save,
+    assert_begin,
+    assert_end,
+    word_boundary,
+    match,
+};
+
+struct instruction
+{
+    opcode op;
+    char c   = 0;
+    size_t x = 0;
+    size_t y = 0;
+};
+
+/**
+ * The positions of a match and its groups in the subject string. Slot 2i
+ * holds the start of group i and slot 2i+1 its end, group 0 being the whole
+ * match. Groups that did not participate in the match have npos in them.
+ */
+struct match
+{
+    std::vector<size_t> slots;
+
+    [[nodiscard]] size_t start() const noexcept
+    {
+        return slots[0];
+    }
+
+    [[nodiscard]] size_t end() const noexcept
+    {
+        return slots[1];
+    }
+
+    /**
+     * Return the text captured by the given group, or an empty optional if the
+     * group did not participate in the match.
+     */
+    [[nodiscard]] std::optional<std::string_view>
+    group(std::string_view subject, size_t) const noexcept;
+};
+
+class program
+{
+public:
+    /**
+     * Compile a pattern.
+     * @return The compiled program, or a message describing the syntax error.
+     */
+    [[nodiscard]] static std::variant<program, std::string>
+    compile(std::string_view pattern) noexcept;
+
+    /**
+     * Find the leftmost match in subject at or after the given position.
+     */
+    [[nodiscard]] std::optional<match>
+    search(std::string_view subject, size_t start = 0) const noexcept;
+
+    /**
+     * Return the number of capturing groups, not counting the whole match.
+     */
+    [[nodiscard]] size_t groups() const noexcept;
+
+private:
+    std::vector<instruction> _instructions;
+    std::vector<std::bitset<256>> _classes;
+    size_t _groups = 0;
+
+    /* A character every match must start with, used to skip ahead. */
+    std::optional<char> _first_char;
+
+    friend class compiler;
+};
+
+}
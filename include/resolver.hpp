@@ -37,6 +37,8 @@ public:
     ResultType visit_lnot_expression(ast::lnot_expression&) override;
     ResultType visit_not_expression(ast::not_expression&) override;
     ResultType visit_perform_expression(ast::perform_expression&) override;
+    ResultType visit_generator_expression(ast::generator_expression&) override;
+    ResultType visit_yield_expression(ast::yield_expression&) override;
     ResultType visit_binary_expression(ast::binary_expression&) override;
     ResultType visit_add_numbers(ast::AddNumbers&) override;
     ResultType visit_less_than_numbers(ast::LessThanNumbers&) override;
@@ -38,13 +38,19 @@ struct TypeConstraint
 enum class TypeKind {
     Any,
     Array,
+    Deque,
     Dictionary,
     Enum,
+    Float64Array,
     Function,
+    Grid,
+    Int64Array,
     Number,
     Sequence,
+    Set,
     String,
     Struct,
+    Tuple,
     Unit,
 };
 
@@ -175,6 +175,16 @@ object perform_expression::accept(ast_visitor& v)
     return v.visit_perform_expression(*this);
 }
 
+object generator_expression::accept(ast_visitor& v)
+{
+    return v.visit_generator_expression(*this);
+}
+
+object yield_expression::accept(ast_visitor& v)
+{
+    return v.visit_yield_expression(*this);
+}
+
 object array::accept(ast_visitor& v)
 {
     return v.visit_array(*this);
@@ -8,11 +8,37 @@
 namespace gaya::eval::object::builtin::array
 {
 
+/*
+ * Array keys of dictionaries and sets come back as tuples, so builtins that
+ * only read their array take tuples too. Those that change it make a new array
+ * from a tuple instead.
+ */
+static bool is_array_like(const object& o) noexcept
+{
+    return IS_ARRAY(o) || IS_TUPLE(o);
+}
+
+static packed_array elements(const object& o) noexcept
+{
+    if (IS_ARRAY(o)) return AS_ARRAY(o);
+
+    const auto& t = AS_TUPLE(o);
+    packed_array elems { o.span };
+    for (size_t i = 0; i < t.size(); i++) elems.push_back(t[i]);
+
+    return elems;
+}
+
 gaya::eval::object::object
 length(interpreter& interp, span span, const std::vector<object>& args) noexcept
 {
     auto a = args[0];
 
+    if (IS_TUPLE(a))
+    {
+        return create_number(span, AS_TUPLE(a).size());
+    }
+
     if (!IS_ARRAY(a))
     {
         interp.interp_error(span, "Expected its argument to be an array");
@@ -25,7 +51,7 @@ length(interpreter& interp, span span, const std::vector<object>& args) noexcept
 gaya::eval::object::object
 concat(interpreter& interp, span span, const std::vector<object>& args) noexcept
 {
-    if (!IS_ARRAY(args[0]) || !IS_ARRAY(args[1]))
+    if (!is_array_like(args[0]) || !is_array_like(args[1]))
     {
         auto t1 = typeof_(args[0]);
         auto t2 = typeof_(args[1]);
@@ -35,9 +61,14 @@ concat(interpreter& interp, span span, const std::vector<object>& args) noexcept
         return gaya::eval::object::invalid;
     }
 
-    auto& a1 = AS_ARRAY(args[0]);
-    auto& a2 = AS_ARRAY(args[1]);
-    a1.insert(a1.cend(), a2.begin(), a2.end());
+    if (IS_TUPLE(args[0]))
+    {
+        auto elems = elements(args[0]);
+        elems.append(elements(args[1]));
+        return create_array(interp, span, std::move(elems));
+    }
+
+    AS_ARRAY(args[0]).append(elements(args[1]));
 
     return args[0];
 }
@@ -51,7 +82,7 @@ push(interpreter& interp, span span, const std::vector<object>& args) noexcept
         return gaya::eval::object::invalid;
     }
 
-    AS_ARRAY(args[0]).push_back(std::move(args[1]));
+    AS_ARRAY(args[0]).push_back(args[1]);
 
     return args[0];
 }
@@ -72,7 +103,7 @@ pop(interpreter& interp, span span, const std::vector<object>& args) noexcept
         return create_unit(span);
     }
 
-    auto value = a.back();
+    auto value = a[a.size() - 1];
     a.pop_back();
 
     return value;
@@ -84,7 +115,7 @@ sort(interpreter& interp, span span, const std::vector<object>& args) noexcept
     auto& a  = args[0];
     auto cmp = args[1];
 
-    if (!IS_ARRAY(a))
+    if (!is_array_like(a))
     {
         interp.interp_error(span, "Expected the first argument to be an array");
         return invalid;
@@ -98,12 +129,20 @@ sort(interpreter& interp, span span, const std::vector<object>& args) noexcept
         return invalid;
     }
 
-    std::sort(AS_ARRAY(a).begin(), AS_ARRAY(a).end(), [&](auto o1, auto o2) {
+    auto elems = elements(a).to_vector();
+    std::sort(elems.begin(), elems.end(), [&](auto o1, auto o2) {
         auto result = call(cmp, interp, span, { o1, o2 });
         assert(is_valid(result));
         return is_truthy(result);
     });
 
+    if (IS_TUPLE(a))
+    {
+        return create_array(interp, span, packed_array { a.span, elems });
+    }
+
+    AS_ARRAY(a) = packed_array { a.span, elems };
+
     return a;
 }
 
@@ -138,9 +177,65 @@ set(interpreter& interp, span span, const std::vector<object>& args) noexcept
                 AS_ARRAY(a).size()));
     }
 
-    AS_ARRAY(a)[AS_NUMBER(index)] = o;
+    AS_ARRAY(a).set(AS_NUMBER(index), o);
 
     return a;
 }
 
+gaya::eval::object::object
+slice(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& a     = args[0];
+    auto& start = args[1];
+    auto& end   = args[2];
+
+    if (!is_array_like(a))
+    {
+        interp.interp_error(span, "Expected the first argument to be an array");
+        return invalid;
+    }
+
+    if (!IS_NUMBER(start) || !IS_NUMBER(end))
+    {
+        interp.interp_error(
+            span,
+            "Expected the second and third arguments to be numbers");
+        return invalid;
+    }
+
+    auto elems = elements(a);
+    auto from  = AS_NUMBER(start);
+    auto to    = AS_NUMBER(end);
+
+    if (from < 0 || from != static_cast<size_t>(from) || to < from
+        || to != static_cast<size_t>(to) || to > elems.size())
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid slice {}..{} of array of size {}",
+                from,
+                to,
+                elems.size()));
+        return invalid;
+    }
+
+    auto view = elems.slice(static_cast<size_t>(from), static_cast<size_t>(to));
+    return create_array(interp, span, std::move(view));
+}
+
+gaya::eval::object::object
+clone(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& a = args[0];
+
+    if (!is_array_like(a))
+    {
+        interp.interp_error(span, "Expected its argument to be an array");
+        return invalid;
+    }
+
+    return create_array(interp, span, elements(a));
+}
+
 }
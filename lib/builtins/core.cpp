@@ -2,6 +2,7 @@
 #include <openssl/md5.h>
 
 #include <builtins/core.hpp>
+#include <builtins/sequence.hpp>
 #include <eval.hpp>
 #include <object.hpp>
 
@@ -112,4 +113,30 @@ md5(interpreter& interp, span span, const std::vector<object>& args) noexcept
     return create_string(interp, span, result);
 }
 
+/* tuple */
+
+gaya::eval::object::object
+tuple_(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (IS_TUPLE(args[0]))
+    {
+        return args[0];
+    }
+
+    if (!is_sequence(args[0]))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Expected a sequence, but got {}",
+                typeof_(args[0])));
+        return invalid;
+    }
+
+    auto elems = sequence::toarray(interp, span, args);
+    if (!is_valid(elems)) return invalid;
+
+    return create_tuple(interp, span, AS_ARRAY(elems));
+}
+
 }
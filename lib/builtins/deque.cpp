@@ -0,0 +1,124 @@
+#include <fmt/core.h>
+
+#include <builtins/deque.hpp>
+#include <eval.hpp>
+
+namespace gaya::eval::object::builtin::deque
+{
+
+/*
+ * Check that the first argument is a deque, reporting an error if it is not.
+ */
+static bool
+expect_deque(interpreter& interp, span span, const object& o) noexcept
+{
+    if (IS_DEQUE(o)) return true;
+
+    interp.interp_error(span, "Expected the first argument to be a deque");
+    return false;
+}
+
+/* deque */
+
+gaya::eval::object::object
+make(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (IS_DEQUE(args[0]))
+    {
+        return create_deque(interp, span, AS_DEQUE(args[0]));
+    }
+
+    if (!is_sequence(args[0]))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Expected a sequence, but got {}",
+                typeof_(args[0])));
+        return invalid;
+    }
+
+    auto xs     = args[0];
+    auto seq    = to_sequence(interp, xs);
+    auto reader = sequence_reader { interp, span, seq, can_prefetch(seq) };
+    auto result = ring_buffer { span };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        result.push_back(x);
+    }
+
+    return create_deque(interp, span, std::move(result));
+}
+
+/* deque.length */
+
+gaya::eval::object::object
+length(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_deque(interp, span, args[0])) return invalid;
+
+    return create_number(span, AS_DEQUE(args[0]).size());
+}
+
+/* deque.pushFront */
+
+gaya::eval::object::object push_front(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_deque(interp, span, args[0])) return invalid;
+
+    AS_DEQUE(args[0]).push_front(args[1]);
+    return args[0];
+}
+
+/* deque.pushBack */
+
+gaya::eval::object::object push_back(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_deque(interp, span, args[0])) return invalid;
+
+    AS_DEQUE(args[0]).push_back(args[1]);
+    return args[0];
+}
+
+/* deque.popFront */
+
+gaya::eval::object::object pop_front(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_deque(interp, span, args[0])) return invalid;
+
+    auto& deque = AS_DEQUE(args[0]);
+    if (deque.empty()) return create_unit(span);
+
+    return deque.pop_front();
+}
+
+/* deque.popBack */
+
+gaya::eval::object::object pop_back(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_deque(interp, span, args[0])) return invalid;
+
+    auto& deque = AS_DEQUE(args[0]);
+    if (deque.empty()) return create_unit(span);
+
+    return deque.pop_back();
+}
+
+}
@@ -35,7 +35,7 @@ set(interpreter& interp, span span, const std::vector<object>& args) noexcept
         return invalid;
     }
 
-    AS_DICT(d).insert_or_assign(k, v);
+    AS_DICT(d).insert_or_assign(interp, k, v);
 
     return d;
 }
@@ -52,10 +52,10 @@ remove(interpreter& interp, span span, const std::vector<object>& args) noexcept
         return invalid;
     }
 
-    if (auto it = AS_DICT(d).find(k); it != AS_DICT(d).end())
+    if (auto index = AS_DICT(d).find(k); index)
     {
-        auto value = it->second;
-        AS_DICT(d).erase(it);
+        auto value = AS_DICT(d).value(*index);
+        AS_DICT(d).erase(*index);
         return value;
     }
 
@@ -68,6 +68,135 @@ remove(interpreter& interp, span span, const std::vector<object>& args) noexcept
     return invalid;
 }
 
+/*
+ * NOTE: Each of these looks the key up once. The callback of dict.update runs
+ *       between that lookup and the store, so the store only goes through the
+ *       entry found if no keys were added or removed in the meantime.
+ */
+
+gaya::eval::object::object
+update(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto d    = args[0];
+    auto k    = args[1];
+    auto func = args[2];
+    auto dflt = args[3];
+
+    if (d.type != object_type_dictionary)
+    {
+        interp.interp_error(span, "Expected first argument to be a dictionary");
+        return invalid;
+    }
+
+    if (!accepts(func, 1))
+    {
+        interp.interp_error(
+            span,
+            "Expected third argument to be a function of 1 argument");
+        return invalid;
+    }
+
+    auto& dict             = AS_DICT(d);
+    auto [index, inserted] = dict.try_emplace(interp, k, dflt);
+    if (inserted) return d;
+
+    auto changes = dict.changes();
+    auto value   = call(func, interp, span, { dict.value(index) });
+    if (!is_valid(value)) return invalid;
+
+    if (dict.changes() == changes)
+    {
+        dict.set_value(index, value);
+    }
+    else
+    {
+        dict.insert_or_assign(interp, k, value);
+    }
+
+    return d;
+}
+
+gaya::eval::object::object increment(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& d  = args[0];
+    auto& k  = args[1];
+    auto& by = args[2];
+
+    if (d.type != object_type_dictionary)
+    {
+        interp.interp_error(span, "Expected first argument to be a dictionary");
+        return invalid;
+    }
+
+    if (!IS_NUMBER(by))
+    {
+        interp.interp_error(span, "Expected third argument to be a number");
+        return invalid;
+    }
+
+    auto& dict  = AS_DICT(d);
+    auto index  = dict.try_emplace(interp, k, create_number(span, 0)).first;
+    auto number = dict.value(index);
+    if (!IS_NUMBER(number))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Expected the value of '{}' to be a number, got {}",
+                to_string(interp, k),
+                typeof_(number)));
+        return invalid;
+    }
+
+    auto result = create_number(span, AS_NUMBER(number) + AS_NUMBER(by));
+    dict.set_value(index, result);
+    return result;
+}
+
+gaya::eval::object::object get_or_insert(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& d    = args[0];
+    auto& k    = args[1];
+    auto& dflt = args[2];
+
+    if (d.type != object_type_dictionary)
+    {
+        interp.interp_error(span, "Expected first argument to be a dictionary");
+        return invalid;
+    }
+
+    auto& dict = AS_DICT(d);
+    return dict.value(dict.try_emplace(interp, k, dflt).first);
+}
+
+gaya::eval::object::object
+pop(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& d    = args[0];
+    auto& k    = args[1];
+    auto& dflt = args[2];
+
+    if (d.type != object_type_dictionary)
+    {
+        interp.interp_error(span, "Expected first argument to be a dictionary");
+        return invalid;
+    }
+
+    auto& dict = AS_DICT(d);
+    auto index = dict.find(k);
+    if (!index) return dflt;
+
+    auto value = dict.value(*index);
+    dict.erase(*index);
+    return value;
+}
+
 gaya::eval::object::object contains(
     interpreter& interp,
     span span,
@@ -92,4 +221,53 @@ gaya::eval::object::object contains(
     }
 }
 
+static gaya::eval::object::object view(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args,
+    dict_sequence_kind kind) noexcept
+{
+    auto d = args[0];
+
+    if (d.type != object_type_dictionary)
+    {
+        interp.interp_error(span, "Expected first argument to be a dictionary");
+        return invalid;
+    }
+
+    return create_dict_sequence(interp, span, d, kind);
+}
+
+gaya::eval::object::object
+keys(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return view(interp, span, args, dict_sequence_keys);
+}
+
+gaya::eval::object::object
+values(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return view(interp, span, args, dict_sequence_values);
+}
+
+gaya::eval::object::object
+items(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return view(interp, span, args, dict_sequence_items);
+}
+
+gaya::eval::object::object
+clone(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& d = args[0];
+
+    if (d.type != object_type_dictionary)
+    {
+        interp.interp_error(span, "Expected first argument to be a dictionary");
+        return invalid;
+    }
+
+    return create_dictionary(interp, span, AS_DICT(d));
+}
+
 }
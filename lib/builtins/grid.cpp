@@ -0,0 +1,474 @@
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include <builtins/grid.hpp>
+#include <eval.hpp>
+
+namespace gaya::eval::object::builtin::grid
+{
+
+/* The most cells grid.new makes, so that a mistyped size reports an error. */
+static constexpr double max_cells = 1 << 28;
+
+/*
+ * Check that the first argument is a grid, reporting an error if it is not.
+ */
+static bool
+expect_grid(interpreter& interp, span span, const object& o) noexcept
+{
+    if (IS_GRID(o)) return true;
+
+    interp.interp_error(span, "Expected the first argument to be a grid");
+    return false;
+}
+
+static bool expect_number(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position) noexcept
+{
+    if (IS_NUMBER(o)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format("Expected the {} argument to be a number", position));
+    return false;
+}
+
+/*
+ * Read the coordinates of a point, given as an array or a tuple of two whole
+ * numbers, reporting an error if it is not one.
+ */
+static bool read_point(
+    interpreter& interp,
+    span span,
+    const object& o,
+    double& x,
+    double& y) noexcept
+{
+    std::optional<object> first, second;
+    if (IS_TUPLE(o) && AS_TUPLE(o).size() == 2)
+    {
+        first  = AS_TUPLE(o)[0];
+        second = AS_TUPLE(o)[1];
+    }
+    else if (IS_ARRAY(o) && AS_ARRAY(o).size() == 2)
+    {
+        first  = AS_ARRAY(o)[0];
+        second = AS_ARRAY(o)[1];
+    }
+
+    auto whole = [](const object& o) {
+        return IS_NUMBER(o) && std::trunc(AS_NUMBER(o)) == AS_NUMBER(o);
+    };
+
+    if (!first || !whole(*first) || !whole(*second))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Expected a point (x, y) of whole numbers, but got {}",
+                to_string(interp, o)));
+        return false;
+    }
+
+    x = AS_NUMBER(*first);
+    y = AS_NUMBER(*second);
+    return true;
+}
+
+static object
+make_point(interpreter& interp, span span, size_t x, size_t y) noexcept
+{
+    std::vector<object> coordinates {
+        create_number(span, static_cast<double>(x)),
+        create_number(span, static_cast<double>(y)),
+    };
+    return create_tuple(interp, span, coordinates);
+}
+
+template <size_t N>
+static object neighbours_of(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args,
+    const std::array<std::pair<int, int>, N>& offsets) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    double x, y;
+    if (!read_point(interp, span, args[1], x, y)) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+
+    std::vector<object> result;
+    result.reserve(N);
+    for (auto [dx, dy] : offsets)
+    {
+        auto nx = x + dx;
+        auto ny = y + dy;
+        if (g.contains(nx, ny))
+        {
+            result.push_back(make_point(
+                interp,
+                span,
+                static_cast<size_t>(nx),
+                static_cast<size_t>(ny)));
+        }
+    }
+
+    return create_array(interp, span, result);
+}
+
+/* grid.new */
+
+gaya::eval::object::object
+make(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_number(interp, span, args[0], "first")) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    auto width  = AS_NUMBER(args[0]);
+    auto height = AS_NUMBER(args[1]);
+    auto valid  = [](double n) {
+        return std::isfinite(n) && n >= 0 && std::trunc(n) == n;
+    };
+
+    if (!valid(width) || !valid(height))
+    {
+        interp.interp_error(
+            span,
+            fmt::format("Invalid size for a grid: {}x{}", width, height));
+        return invalid;
+    }
+
+    if (width * height > max_cells)
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "A grid of {}x{} is too large, it can have at most {} cells",
+                width,
+                height,
+                max_cells));
+        return invalid;
+    }
+
+    auto g = dense_grid {
+        span,
+        static_cast<size_t>(width),
+        static_cast<size_t>(height),
+        args[2],
+    };
+    return create_grid(interp, span, std::move(g));
+}
+
+/* grid.fromString */
+
+gaya::eval::object::object from_string(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!IS_STRING(args[0]))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Expected a string, but got {}",
+                typeof_(args[0])));
+        return invalid;
+    }
+
+    auto g = dense_grid::from_string(interp, span, AS_STRING(args[0]));
+    if (!g)
+    {
+        interp.interp_error(span, "Grid lines must all be the same length");
+        return invalid;
+    }
+
+    return create_grid(interp, span, std::move(*g));
+}
+
+/* grid.width */
+
+gaya::eval::object::object
+width(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    return create_number(span, AS_GRID(args[0]).width());
+}
+
+/* grid.height */
+
+gaya::eval::object::object
+height(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    return create_number(span, AS_GRID(args[0]).height());
+}
+
+/* grid.get */
+
+gaya::eval::object::object
+get(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    double x, y;
+    if (!read_point(interp, span, args[1], x, y)) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+    if (!g.contains(x, y)) return create_unit(span);
+
+    return g.at(static_cast<size_t>(x), static_cast<size_t>(y));
+}
+
+/* grid.set */
+
+gaya::eval::object::object
+set(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    double x, y;
+    if (!read_point(interp, span, args[1], x, y)) return invalid;
+
+    auto& g = AS_GRID(args[0]);
+    if (!g.contains(x, y))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid point for grid of size {}x{}: ({}, {})",
+                g.width(),
+                g.height(),
+                x,
+                y));
+        return invalid;
+    }
+
+    g.set(static_cast<size_t>(x), static_cast<size_t>(y), args[2]);
+    return args[0];
+}
+
+/* grid.neighbours */
+
+gaya::eval::object::object neighbours(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    static constexpr std::array<std::pair<int, int>, 4> offsets { {
+        { 0, -1 },
+        { 1, 0 },
+        { 0, 1 },
+        { -1, 0 },
+    } };
+
+    return neighbours_of(interp, span, args, offsets);
+}
+
+/* grid.neighbours8 */
+
+gaya::eval::object::object neighbours8(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    static constexpr std::array<std::pair<int, int>, 8> offsets { {
+        { -1, -1 },
+        { 0, -1 },
+        { 1, -1 },
+        { -1, 0 },
+        { 1, 0 },
+        { -1, 1 },
+        { 0, 1 },
+        { 1, 1 },
+    } };
+
+    return neighbours_of(interp, span, args, offsets);
+}
+
+/* grid.row */
+
+gaya::eval::object::object
+row(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+    auto y        = AS_NUMBER(args[1]);
+    if (!g.contains(0, y))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid row for grid of height {}: {}",
+                g.height(),
+                y));
+        return invalid;
+    }
+
+    std::vector<object> cells;
+    cells.reserve(g.width());
+    for (size_t x = 0; x < g.width(); x++)
+    {
+        cells.push_back(g.at(x, static_cast<size_t>(y)));
+    }
+
+    return create_array(interp, span, cells);
+}
+
+/* grid.column */
+
+gaya::eval::object::object
+column(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+    auto x        = AS_NUMBER(args[1]);
+    if (!g.contains(x, 0))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid column for grid of width {}: {}",
+                g.width(),
+                x));
+        return invalid;
+    }
+
+    std::vector<object> cells;
+    cells.reserve(g.height());
+    for (size_t y = 0; y < g.height(); y++)
+    {
+        cells.push_back(g.at(static_cast<size_t>(x), y));
+    }
+
+    return create_array(interp, span, cells);
+}
+
+/* grid.find */
+
+gaya::eval::object::object
+find(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+    for (size_t i = 0; i < g.size(); i++)
+    {
+        if (equals(g[i], args[1]))
+        {
+            return make_point(interp, span, i % g.width(), i / g.width());
+        }
+    }
+
+    return create_unit(span);
+}
+
+/* grid.findAll */
+
+gaya::eval::object::object find_all(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+
+    std::vector<object> points;
+    for (size_t i = 0; i < g.size(); i++)
+    {
+        if (equals(g[i], args[1]))
+        {
+            points.push_back(
+                make_point(interp, span, i % g.width(), i / g.width()));
+        }
+    }
+
+    return create_array(interp, span, points);
+}
+
+/* grid.floodFill */
+
+gaya::eval::object::object flood_fill(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    double x, y;
+    if (!read_point(interp, span, args[1], x, y)) return invalid;
+
+    const auto& g = AS_GRID(args[0]);
+    if (!g.contains(x, y))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid point for grid of size {}x{}: ({}, {})",
+                g.width(),
+                g.height(),
+                x,
+                y));
+        return invalid;
+    }
+
+    auto width = g.width();
+    auto start = static_cast<size_t>(y) * width + static_cast<size_t>(x);
+    auto value = g[start];
+
+    /* The search runs over cell indices and only makes points for the cells
+     * it keeps. */
+    std::vector<bool> seen(g.size());
+    std::vector<size_t> pending { start };
+    seen[start] = true;
+
+    auto region = hash_set { span };
+    while (!pending.empty())
+    {
+        auto i = pending.back();
+        pending.pop_back();
+        region.insert(interp, make_point(interp, span, i % width, i / width));
+
+        auto visit = [&](size_t j) {
+            if (!seen[j] && equals(g[j], value))
+            {
+                seen[j] = true;
+                pending.push_back(j);
+            }
+        };
+
+        if (i >= width) visit(i - width);
+        if (i % width + 1 < width) visit(i + 1);
+        if (i + width < g.size()) visit(i + width);
+        if (i % width > 0) visit(i - 1);
+    }
+
+    return create_set(interp, span, std::move(region));
+}
+
+/* grid.copy */
+
+gaya::eval::object::object
+copy(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_grid(interp, span, args[0])) return invalid;
+
+    return create_grid(interp, span, AS_GRID(args[0]));
+}
+
+}
@@ -1,7 +1,3 @@
-#include <iostream>
-
-#include <fmt/core.h>
-
 #include <builtins/io.hpp>
 #include <eval.hpp>
 #include <file_reader.hpp>
@@ -10,45 +6,97 @@
 namespace gaya::eval::object::builtin::io
 {
 
-gaya::eval::object::object println(
-    interpreter& interp,
-    span span,
-    const std::vector<object>& args) noexcept
+/*
+ * Write the text representation of an object to the interpreter's output.
+ */
+static void write_object(interpreter& interp, object o) noexcept
 {
-    if (IS_STRING(args[0]))
+    auto& output = interp.output();
+
+    if (IS_STRING(o))
     {
-        fmt::println("{}", AS_STRING(args[0]));
+        output.write(AS_STRING(o));
+    }
+    else if (IS_SEQUENCE(o))
+    {
+        /*
+         * NOTE: Consuming a sequence can run code that prints, so it is
+         *       formatted on the side to keep that output before this one.
+         */
+        output.write(to_string(interp, o));
     }
     else
     {
-        auto line = to_string(interp, args[0]);
-        fmt::println("{}", line);
+        to_string(interp, o, output.pending());
+        output.commit();
     }
+}
 
+gaya::eval::object::object println(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    write_object(interp, args[0]);
+    interp.output().put('\n');
     return create_unit(span);
 }
 
 gaya::eval::object::object
 print(interpreter& interp, span span, const std::vector<object>& args) noexcept
 {
-    if (IS_STRING(args[0]))
-    {
-        fmt::print("{}", AS_STRING(args[0]));
-    }
-    else
+    write_object(interp, args[0]);
+    return create_unit(span);
+}
+
+gaya::eval::object::object
+flush(interpreter& interp, span span, const std::vector<object>&) noexcept
+{
+    interp.output().flush();
+    return create_unit(span);
+}
+
+gaya::eval::object::object set_buffer_size(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!IS_NUMBER(args[0]) || AS_NUMBER(args[0]) < 0)
     {
-        auto line = to_string(interp, args[0]);
-        fmt::print("{}", line);
+        interp.interp_error(
+            span,
+            "Expected the first argument to be a non-negative number");
+        return invalid;
     }
+
+    interp.output().set_capacity(static_cast<size_t>(AS_NUMBER(args[0])));
     return create_unit(span);
 }
 
 gaya::eval::object::object
 readline(interpreter& interp, span span, const std::vector<object>&) noexcept
 {
-    std::string line;
-    std::getline(std::cin, line);
-    return create_string(interp, span, std::move(line));
+    /* Make sure prompts are visible before blocking on input. */
+    interp.output().flush();
+
+    auto line = stdin_reader()->next();
+    return create_string(interp, span, line.value_or(""));
+}
+
+gaya::eval::object::object
+stdin_(interpreter& interp, span span, const std::vector<object>&) noexcept
+{
+    interp.output().flush();
+    return create_lines_sequence(interp, span, stdin_reader());
+}
+
+gaya::eval::object::object stdin_chunks(
+    interpreter& interp,
+    span span,
+    const std::vector<object>&) noexcept
+{
+    interp.output().flush();
+    return create_lines_sequence(interp, span, stdin_reader(), true);
 }
 
 gaya::eval::object::object readfile(
@@ -70,14 +118,29 @@ gaya::eval::object::object readfile(
     }
 
     /*
-     * NOTE: We don't free contents because the returned string will take
-     *       ownership of it.
+     * NOTE: The mapping is released when the reader goes out of scope, so the
+     *       contents are only copied once, into the string object.
      */
-    char* contents = reader.slurp();
-    assert(contents);
-    std::string contents_as_string(contents);
+    auto contents = reader.map();
+    if (!contents)
+    {
+        return create_unit(span);
+    }
+
+    return create_string(interp, span, *contents);
+}
+
+gaya::eval::object::object
+lines(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& filename = args[0];
+    if (!IS_STRING(filename))
+    {
+        interp.interp_error(span, "Expected first argument to be a string");
+        return invalid;
+    }
 
-    return create_string(interp, span, std::string { contents });
+    return create_lines_sequence(interp, span, AS_STRING(filename));
 }
 
 gaya::eval::object::object listdir(
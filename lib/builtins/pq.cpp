@@ -0,0 +1,147 @@
+#include <fmt/core.h>
+
+#include <builtins/pq.hpp>
+#include <eval.hpp>
+
+namespace gaya::eval::object::builtin::pq
+{
+
+/*
+ * Check that the first argument is a priority queue, reporting an error if it
+ * is not.
+ */
+static bool
+expect_queue(interpreter& interp, span span, const object& o) noexcept
+{
+    if (IS_PRIORITY_QUEUE(o)) return true;
+
+    interp.interp_error(
+        span,
+        "Expected the first argument to be a priority queue");
+    return false;
+}
+
+static bool expect_number(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position) noexcept
+{
+    if (IS_NUMBER(o)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format(
+            "Expected the {} argument to be a number, but got {}",
+            position,
+            typeof_(o)));
+    return false;
+}
+
+/* pq.new */
+
+gaya::eval::object::object
+make(interpreter& interp, span span, const std::vector<object>&) noexcept
+{
+    return create_priority_queue(interp, span, priority_queue { span });
+}
+
+/* pq.length */
+
+gaya::eval::object::object
+length(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_queue(interp, span, args[0])) return invalid;
+
+    return create_number(span, AS_PRIORITY_QUEUE(args[0]).size());
+}
+
+/* pq.push */
+
+gaya::eval::object::object
+push(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_queue(interp, span, args[0])) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    auto& queue = AS_PRIORITY_QUEUE(args[0]);
+    auto handle = queue.push(AS_NUMBER(args[1]), args[2]);
+    return create_number(span, static_cast<double>(handle));
+}
+
+/* pq.pop */
+
+gaya::eval::object::object
+pop(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_queue(interp, span, args[0])) return invalid;
+
+    auto& queue = AS_PRIORITY_QUEUE(args[0]);
+    if (queue.empty()) return create_unit(span);
+
+    auto value = queue.top();
+    queue.pop();
+    return value;
+}
+
+/* pq.peek */
+
+gaya::eval::object::object
+peek(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_queue(interp, span, args[0])) return invalid;
+
+    const auto& queue = AS_PRIORITY_QUEUE(args[0]);
+    if (queue.empty()) return create_unit(span);
+
+    return queue.top();
+}
+
+/* pq.priority */
+
+gaya::eval::object::object priority(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_queue(interp, span, args[0])) return invalid;
+
+    const auto& queue = AS_PRIORITY_QUEUE(args[0]);
+    if (queue.empty()) return create_unit(span);
+
+    return create_number(span, queue.top_priority());
+}
+
+/* pq.decrease */
+
+gaya::eval::object::object decrease(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_queue(interp, span, args[0])) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+    if (!expect_number(interp, span, args[2], "third")) return invalid;
+
+    auto& queue = AS_PRIORITY_QUEUE(args[0]);
+    auto handle = AS_NUMBER(args[1]);
+
+    if (!queue.valid_handle(handle))
+    {
+        interp.interp_error(
+            span,
+            fmt::format("{} is not a handle of this priority queue", handle));
+        return invalid;
+    }
+
+    if (queue.decrease(static_cast<size_t>(handle), AS_NUMBER(args[2])))
+    {
+        return create_number(span, 1);
+    }
+    else
+    {
+        return create_unit(span);
+    }
+}
+
+}
@@ -0,0 +1,193 @@
+#include <memory>
+
+#include <fmt/core.h>
+#include <robin_hood.h>
+
+#include <builtins/re.hpp>
+#include <eval.hpp>
+#include <regex.hpp>
+
+namespace gaya::eval::object::builtin::re
+{
+
+/*
+ * Compiled patterns, keyed by their source. Patterns are usually string
+ * literals inside loops, so each one is compiled only the first time it is
+ * used.
+ *
+ * Patterns built at run time could fill it without end, so it is emptied
+ * once it holds max_programs of them, as Python's re module does. Programs
+ * still in use are kept alive by their shared pointers.
+ */
+static constexpr size_t max_programs = 256;
+
+static robin_hood::unordered_map<std::string, std::shared_ptr<regex::program>>
+    programs;
+
+static std::shared_ptr<regex::program> compile(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& pattern = args[0];
+    auto& s       = args[1];
+
+    if (!IS_STRING(pattern) || !IS_STRING(s))
+    {
+        interp.interp_error(span, "Expected both arguments to be strings");
+        return nullptr;
+    }
+
+    auto& source = AS_STRING(pattern);
+    if (auto it = programs.find(source); it != programs.end())
+    {
+        return it->second;
+    }
+
+    auto compiled = regex::program::compile(source);
+    if (auto* error = std::get_if<std::string>(&compiled); error)
+    {
+        interp.interp_error(
+            span,
+            fmt::format("Invalid regular expression: {}", *error));
+        return nullptr;
+    }
+
+    auto program = std::make_shared<regex::program>(
+        std::move(std::get<regex::program>(compiled)));
+    if (programs.size() >= max_programs) programs.clear();
+    programs.insert({ source, program });
+
+    return program;
+}
+
+static object create_group(
+    interpreter& interp,
+    span span,
+    std::string_view subject,
+    const regex::match& m,
+    size_t group) noexcept
+{
+    if (auto text = m.group(subject, group); text)
+    {
+        return create_string(interp, span, *text);
+    }
+    return create_unit(span);
+}
+
+static object create_groups(
+    interpreter& interp,
+    span span,
+    std::string_view subject,
+    const regex::match& m,
+    size_t groups) noexcept
+{
+    std::vector<object> elems;
+    elems.reserve(groups);
+
+    for (size_t i = 1; i <= groups; i++)
+    {
+        elems.push_back(create_group(interp, span, subject, m, i));
+    }
+
+    return create_array(interp, span, std::move(elems));
+}
+
+gaya::eval::object::object
+match(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto program = compile(interp, span, args);
+    if (!program) return invalid;
+
+    std::string_view subject = AS_STRING(args[1]);
+    if (auto m = program->search(subject); m)
+    {
+        return create_group(interp, span, subject, *m, 0);
+    }
+
+    return create_unit(span);
+}
+
+gaya::eval::object::object findall(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto program = compile(interp, span, args);
+    if (!program) return invalid;
+
+    std::string_view subject = AS_STRING(args[1]);
+    auto groups              = program->groups();
+    std::vector<object> matches;
+
+    size_t pos = 0;
+    while (pos <= subject.size())
+    {
+        auto m = program->search(subject, pos);
+        if (!m) break;
+
+        if (groups == 0)
+        {
+            matches.push_back(create_group(interp, span, subject, *m, 0));
+        }
+        else
+        {
+            matches.push_back(create_groups(interp, span, subject, *m, groups));
+        }
+
+        pos = m->end() == m->start() ? m->end() + 1 : m->end();
+    }
+
+    return create_array(interp, span, std::move(matches));
+}
+
+gaya::eval::object::object captures(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto program = compile(interp, span, args);
+    if (!program) return invalid;
+
+    std::string_view subject = AS_STRING(args[1]);
+    if (auto m = program->search(subject); m)
+    {
+        return create_groups(interp, span, subject, *m, program->groups());
+    }
+
+    return create_unit(span);
+}
+
+gaya::eval::object::object
+split(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto program = compile(interp, span, args);
+    if (!program) return invalid;
+
+    std::string_view subject = AS_STRING(args[1]);
+    std::vector<object> parts;
+
+    size_t start = 0;
+    size_t pos   = 0;
+    while (pos <= subject.size())
+    {
+        auto m = program->search(subject, pos);
+        if (!m) break;
+
+        if (m->end() == m->start())
+        {
+            pos = m->end() + 1;
+            continue;
+        }
+
+        auto part = subject.substr(start, m->start() - start);
+        parts.push_back(create_string(interp, span, part));
+        start = pos = m->end();
+    }
+
+    parts.push_back(create_string(interp, span, subject.substr(start)));
+
+    return create_array(interp, span, std::move(parts));
+}
+
+}
@@ -1,6 +1,7 @@
 #include <fmt/core.h>
 
 #include <builtins/sequence.hpp>
+#include <builtins/typed.hpp>
 #include <eval.hpp>
 
 namespace gaya::eval::object::builtin::sequence
@@ -66,4 +67,668 @@ copy(interpreter& interp, span span, const std::vector<object>& args) noexcept
     return copy_sequence(interp, span, AS_SEQUENCE(args[0]));
 }
 
+/*
+ * Check that the argument at the given position is a sequence, reporting an
+ * error if it is not.
+ */
+static bool expect_sequence(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position) noexcept
+{
+    if (is_sequence(o)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format("Expected the {} argument to be a sequence", position));
+    return false;
+}
+
+/*
+ * Check that the argument at the given position is a callable that can be
+ * called with the given number of arguments, reporting an error if it is not.
+ */
+static bool expect_callable(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position,
+    size_t expected_arity) noexcept
+{
+    if (accepts(o, expected_arity)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format(
+            "Expected the {} argument to be a function of {} argument{}",
+            position,
+            expected_arity,
+            expected_arity == 1 ? "" : "s"));
+    return false;
+}
+
+/*
+ * Check that the argument at the given position is a number, reporting an
+ * error if it is not.
+ */
+static bool expect_number(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position) noexcept
+{
+    if (IS_NUMBER(o)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format("Expected the {} argument to be a number", position));
+    return false;
+}
+
+/*
+ * Convert the first argument of a combinator to a sequence object.
+ */
+static object source(interpreter& interp, const object& o) noexcept
+{
+    auto xs = o;
+    return to_sequence(interp, xs);
+}
+
+/* seq.range */
+
+gaya::eval::object::object
+range(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_number(interp, span, args[0], "first")) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    return create_number_sequence(
+        interp,
+        span,
+        AS_NUMBER(args[1]),
+        AS_NUMBER(args[0]));
+}
+
+/* seq.map */
+
+gaya::eval::object::object
+map(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    map_sequence map_seq = { source(interp, args[0]), args[1] };
+    map_seq.batched      = can_read_ahead(args[0], map_seq.inner);
+    return create_sequence(interp, { span, sequence_type_map, map_seq });
+}
+
+/* seq.filter */
+
+gaya::eval::object::object
+filter(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    filter_sequence filter_seq = { source(interp, args[0]), args[1] };
+    filter_seq.batched         = can_read_ahead(args[0], filter_seq.inner);
+    return create_sequence(interp, { span, sequence_type_filter, filter_seq });
+}
+
+/* seq.take */
+
+gaya::eval::object::object
+take(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    take_sequence take_seq = { source(interp, args[0]), AS_NUMBER(args[1]) };
+    return create_sequence(interp, { span, sequence_type_take, take_seq });
+}
+
+/* seq.drop */
+
+gaya::eval::object::object
+drop(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    drop_sequence drop_seq = { source(interp, args[0]), AS_NUMBER(args[1]) };
+    return create_sequence(interp, { span, sequence_type_drop, drop_seq });
+}
+
+/* seq.takewhile */
+
+gaya::eval::object::object takewhile(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    takewhile_sequence takewhile_seq = { source(interp, args[0]), args[1] };
+    return create_sequence(
+        interp,
+        { span, sequence_type_takewhile, takewhile_seq });
+}
+
+/* seq.dropwhile */
+
+gaya::eval::object::object dropwhile(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    dropwhile_sequence dropwhile_seq = { source(interp, args[0]), args[1] };
+    return create_sequence(
+        interp,
+        { span, sequence_type_dropwhile, dropwhile_seq });
+}
+
+/* seq.enumerate */
+
+gaya::eval::object::object enumerate(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    enumerate_sequence enumerate_seq = { source(interp, args[0]) };
+    return create_sequence(
+        interp,
+        { span, sequence_type_enumerate, enumerate_seq });
+}
+
+/* seq.flatten */
+
+gaya::eval::object::object flatten(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    flatten_sequence flatten_seq = {
+        source(interp, args[0]),
+        create_unit(span),
+    };
+    return create_sequence(
+        interp,
+        { span, sequence_type_flatten, flatten_seq });
+}
+
+/* seq.concatMap */
+
+gaya::eval::object::object concat_map(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto mapped = map(interp, span, args);
+    if (!is_valid(mapped)) return invalid;
+
+    return flatten(interp, span, { mapped });
+}
+
+/* seq.foreach */
+
+gaya::eval::object::object for_each(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    auto xs      = source(interp, args[0]);
+    auto func    = args[1];
+    auto batched = can_read_ahead(args[0], xs);
+    auto reader  = sequence_reader { interp, span, xs, batched };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        auto result = call(func, interp, span, { x });
+        if (!is_valid(result)) return invalid;
+    }
+
+    return create_unit(span);
+}
+
+/* seq.reduce */
+
+gaya::eval::object::object
+reduce(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[2], "third", 2)) return invalid;
+
+    auto xs      = source(interp, args[0]);
+    auto acc     = args[1];
+    auto func    = args[2];
+    auto batched = can_read_ahead(args[0], xs);
+    auto reader  = sequence_reader { interp, span, xs, batched };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        acc = call(func, interp, span, { acc, x });
+        if (!is_valid(acc)) return invalid;
+    }
+
+    return acc;
+}
+
+/* seq.sum */
+
+gaya::eval::object::object
+sum(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    /* Typed arrays have their numbers unboxed, and add them up in lanes. */
+    if (IS_TYPED_ARRAY(args[0])) return typed::sum(interp, span, args);
+
+    auto xs      = source(interp, args[0]);
+    auto reader  = sequence_reader { interp, span, xs, true };
+    double total = 0;
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        if (!IS_NUMBER(x))
+        {
+            interp.interp_error(
+                span,
+                fmt::format("Expected {} to be a Number", typeof_(x)));
+            return invalid;
+        }
+
+        total += AS_NUMBER(x);
+    }
+
+    return create_number(span, total);
+}
+
+/* seq.count */
+
+gaya::eval::object::object
+count(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    /* Sequences that know their size are consumed by skipping all of it. */
+    auto xs   = source(interp, args[0]);
+    auto size = exact_size(xs);
+    if (size && skip(xs, *size))
+    {
+        return create_number(span, static_cast<double>(*size));
+    }
+
+    auto reader  = sequence_reader { interp, span, xs, true };
+    double total = 0;
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        total += 1;
+    }
+
+    return create_number(span, total);
+}
+
+/* seq.groupBy */
+
+gaya::eval::object::object group_by(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    auto xs      = source(interp, args[0]);
+    auto func    = args[1];
+    auto batched = can_read_ahead(args[0], xs);
+    auto reader  = sequence_reader { interp, span, xs, batched };
+    auto result = create_dictionary(interp, span, dictionary { span });
+    auto& dict  = AS_DICT(result);
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        auto key = call(func, interp, span, { x });
+        if (!is_valid(key)) return invalid;
+
+        auto [index, inserted] = dict.try_emplace(interp, key, invalid);
+        if (inserted) dict.set_value(index, create_array(interp, span, {}));
+
+        AS_ARRAY(dict.value(index)).push_back(x);
+    }
+
+    return result;
+}
+
+/*
+ * Count the elements of xs by the key func computes for them, or by the
+ * elements themselves if func is unit.
+ */
+static object tally(
+    interpreter& interp,
+    span span,
+    const object& xs_arg,
+    object func) noexcept
+{
+    auto keyed   = !IS_UNIT(func);
+    auto xs      = source(interp, xs_arg);
+    auto batched = !keyed || can_read_ahead(xs_arg, xs);
+    auto reader  = sequence_reader { interp, span, xs, batched };
+    auto result  = create_dictionary(interp, span, dictionary { span });
+    auto& dict   = AS_DICT(result);
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        auto key = keyed ? call(func, interp, span, { x }) : x;
+        if (!is_valid(key)) return invalid;
+
+        auto zero  = create_number(span, 0);
+        auto index = dict.try_emplace(interp, key, zero).first;
+        auto count = AS_NUMBER(dict.value(index)) + 1;
+        dict.set_value(index, create_number(span, count));
+    }
+
+    return result;
+}
+
+/* seq.countBy */
+
+gaya::eval::object::object count_by(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    return tally(interp, span, args[0], args[1]);
+}
+
+/* seq.histogram */
+
+gaya::eval::object::object histogram(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    return tally(interp, span, args[0], create_unit(span));
+}
+
+/* seq.unique */
+
+gaya::eval::object::object
+unique(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    unique_sequence unique_seq = { source(interp, args[0]), {} };
+    return create_sequence(interp, { span, sequence_type_unique, unique_seq });
+}
+
+/*
+ * Return whether pred holds for any element of xs if `wanted` is true, or
+ * whether it fails for any of them if it is false.
+ */
+static object find_any(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args,
+    bool wanted) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_callable(interp, span, args[1], "second", 1)) return invalid;
+
+    auto xs      = source(interp, args[0]);
+    auto pred    = args[1];
+    auto batched = can_read_ahead(args[0], xs);
+    auto reader  = sequence_reader { interp, span, xs, batched };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        auto result = call(pred, interp, span, { x });
+        if (!is_valid(result)) return invalid;
+
+        if (is_truthy(result) == wanted)
+        {
+            return create_number(span, 1);
+        }
+    }
+
+    return create_number(span, 0);
+}
+
+/* seq.any */
+
+gaya::eval::object::object
+any(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return find_any(interp, span, args, true);
+}
+
+/* seq.all */
+
+gaya::eval::object::object
+all(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto failed = find_any(interp, span, args, false);
+    if (!is_valid(failed)) return invalid;
+
+    return create_number(span, !is_truthy(failed));
+}
+
+/*
+ * Return the element of xs that compares first according to `order`, which is
+ * -1 to find the least element and 1 to find the greatest. Ties are resolved
+ * in favour of later elements, as fn.min and fn.max do.
+ */
+static object
+extreme(interpreter& interp, span span, const object& o, int order) noexcept
+{
+    if (!expect_sequence(interp, span, o, "first")) return invalid;
+
+    auto reader = sequence_reader { interp, span, source(interp, o), true };
+    auto best   = reader.next();
+    if (!is_valid(best) || IS_UNIT(best)) return best;
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        int result;
+        if (!is_comparable(best) || !is_comparable(x)
+            || !cmp(best, x, &result))
+        {
+            interp.interp_error(
+                span,
+                fmt::format(
+                    "{} and {} are not both comparable",
+                    typeof_(best),
+                    typeof_(x)));
+            return invalid;
+        }
+
+        if (result != order)
+        {
+            best = x;
+        }
+    }
+
+    return best;
+}
+
+/* seq.min */
+
+gaya::eval::object::object
+min(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return extreme(interp, span, args[0], -1);
+}
+
+/* seq.max */
+
+gaya::eval::object::object
+max(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return extreme(interp, span, args[0], 1);
+}
+
+/* seq.toarray */
+
+gaya::eval::object::object toarray(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (IS_ARRAY(args[0]))
+    {
+        return args[0];
+    }
+
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+
+    auto xs   = source(interp, args[0]);
+    auto size = exact_size(xs);
+    std::vector<object> elems;
+
+    if (size && element_at(interp, span, xs, 0))
+    {
+        elems.reserve(*size);
+
+        for (size_t i = 0; i < *size; i++)
+        {
+            elems.push_back(*element_at(interp, span, xs, i));
+        }
+
+        (void)skip(xs, *size);
+        return create_array(interp, span, std::move(elems));
+    }
+
+    if (size) elems.reserve(*size);
+
+    auto reader = sequence_reader { interp, span, xs, true };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        elems.push_back(x);
+    }
+
+    return create_array(interp, span, std::move(elems));
+}
+
+/*
+ * Return a sequence over the prefixes or the suffixes of the elements of xs.
+ */
+static object segments(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args,
+    bool suffixes) noexcept
+{
+    auto elems = toarray(interp, span, args);
+    if (!is_valid(elems)) return invalid;
+
+    segments_sequence segments_seq = {
+        elems,
+        AS_ARRAY(elems).size(),
+        suffixes,
+    };
+    return create_sequence(
+        interp,
+        { span, sequence_type_segments, segments_seq });
+}
+
+/* seq.inits */
+
+gaya::eval::object::object
+inits(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return segments(interp, span, args, false);
+}
+
+/* seq.tails */
+
+gaya::eval::object::object
+tails(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return segments(interp, span, args, true);
+}
+
+/* seq.tee */
+
+gaya::eval::object::object
+tee(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sequence(interp, span, args[0], "first")) return invalid;
+    if (!expect_number(interp, span, args[1], "second")) return invalid;
+
+    auto n = AS_NUMBER(args[1]);
+    if (n < 0 || n != static_cast<size_t>(n))
+    {
+        interp.interp_error(
+            span,
+            "Expected the second argument to be a non-negative integer");
+        return invalid;
+    }
+
+    auto buffer = std::make_shared<tee_buffer>(source(interp, args[0]));
+    std::vector<object> cursors;
+
+    for (size_t i = 0; i < static_cast<size_t>(n); i++)
+    {
+        tee_sequence tee_seq = { buffer, buffer->add_cursor(0) };
+        cursors.push_back(
+            create_sequence(interp, { span, sequence_type_tee, tee_seq }));
+    }
+
+    return create_array(interp, span, std::move(cursors));
+}
+
 }
@@ -0,0 +1,207 @@
+#include <fmt/core.h>
+
+#include <builtins/set.hpp>
+#include <eval.hpp>
+
+namespace gaya::eval::object::builtin::set
+{
+
+/*
+ * Check that the argument at the given position is a set, reporting an error
+ * if it is not.
+ */
+static bool expect_set(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position) noexcept
+{
+    if (IS_SET(o)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format("Expected the {} argument to be a set", position));
+    return false;
+}
+
+static bool expect_sets(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    return expect_set(interp, span, args[0], "first")
+        && expect_set(interp, span, args[1], "second");
+}
+
+/* set */
+
+gaya::eval::object::object
+make(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (IS_SET(args[0]))
+    {
+        return create_set(interp, span, AS_SET(args[0]));
+    }
+
+    if (!is_sequence(args[0]))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Expected a sequence, but got {}",
+                typeof_(args[0])));
+        return invalid;
+    }
+
+    auto xs     = args[0];
+    auto seq    = to_sequence(interp, xs);
+    auto reader = sequence_reader { interp, span, seq, can_prefetch(seq) };
+    auto result = hash_set { span };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        result.insert(interp, x);
+    }
+
+    return create_set(interp, span, std::move(result));
+}
+
+/* set.length */
+
+gaya::eval::object::object
+length(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_set(interp, span, args[0], "first")) return invalid;
+
+    return create_number(span, AS_SET(args[0]).size());
+}
+
+/* set.add */
+
+gaya::eval::object::object
+add(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_set(interp, span, args[0], "first")) return invalid;
+
+    AS_SET(args[0]).insert(interp, args[1]);
+    return args[0];
+}
+
+/* set.remove */
+
+gaya::eval::object::object
+remove(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_set(interp, span, args[0], "first")) return invalid;
+
+    AS_SET(args[0]).remove(args[1]);
+    return args[0];
+}
+
+/* set.contains */
+
+gaya::eval::object::object contains(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_set(interp, span, args[0], "first")) return invalid;
+
+    if (AS_SET(args[0]).contains(args[1]))
+    {
+        return create_number(span, 1);
+    }
+    else
+    {
+        return create_unit(span);
+    }
+}
+
+/*
+ * NOTE: The operations below walk the smaller of the two sets where they can,
+ *       and only look elements up in the larger one.
+ */
+
+/* set.union */
+
+gaya::eval::object::object
+union_(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_sets(interp, span, args)) return invalid;
+
+    const auto& a = AS_SET(args[0]);
+    const auto& b = AS_SET(args[1]);
+
+    const auto& larger  = a.size() >= b.size() ? a : b;
+    const auto& smaller = a.size() >= b.size() ? b : a;
+
+    auto result = larger;
+    for (const auto& x : smaller)
+    {
+        result.insert(interp, x);
+    }
+
+    return create_set(interp, span, std::move(result));
+}
+
+/* set.intersection */
+
+gaya::eval::object::object intersection(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sets(interp, span, args)) return invalid;
+
+    const auto& a = AS_SET(args[0]);
+    const auto& b = AS_SET(args[1]);
+
+    const auto& larger  = a.size() >= b.size() ? a : b;
+    const auto& smaller = a.size() >= b.size() ? b : a;
+
+    auto result = hash_set { span };
+    for (const auto& x : smaller)
+    {
+        if (larger.contains(x)) result.insert(interp, x);
+    }
+
+    return create_set(interp, span, std::move(result));
+}
+
+/* set.difference */
+
+gaya::eval::object::object difference(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_sets(interp, span, args)) return invalid;
+
+    const auto& a = AS_SET(args[0]);
+    const auto& b = AS_SET(args[1]);
+
+    if (b.size() < a.size())
+    {
+        auto result = a;
+        for (const auto& x : b)
+        {
+            result.remove(x);
+        }
+
+        return create_set(interp, span, std::move(result));
+    }
+
+    auto result = hash_set { span };
+    for (const auto& x : a)
+    {
+        if (!b.contains(x)) result.insert(interp, x);
+    }
+
+    return create_set(interp, span, std::move(result));
+}
+
+}
@@ -1,3 +1,5 @@
+#include <charconv>
+#include <cstdint>
 #include <cstring>
 
 #include <fmt/core.h>
@@ -8,6 +10,96 @@
 namespace gaya::eval::object::builtin::string
 {
 
+static inline bool is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+/*
+ * Return a pointer to the first digit in [p, end), or end if there is none.
+ *
+ * Eight bytes are tested at once while none of them is a digit, which is the
+ * common case for the text between numbers in puzzle inputs.
+ */
+static const char* skip_to_digit(const char* p, const char* end) noexcept
+{
+    constexpr uint64_t ones = ~uint64_t { 0 } / 255;
+    constexpr uint64_t low  = ones * 127;
+    constexpr uint64_t high = ones * 128;
+
+    while (end - p >= 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+
+        /* Set the high bit of every byte in the range '0'..'9'. */
+        auto digits = ((ones * (127 + '9' + 1)) - (word & low)) & ~word
+            & ((word & low) + ones * (127 - ('0' - 1))) & high;
+        if (digits) break;
+
+        p += 8;
+    }
+
+    while (p < end && !is_digit(*p))
+    {
+        p += 1;
+    }
+
+    return p;
+}
+
+/*
+ * Append the numbers in s to out. When signed_integers is set only integers
+ * are parsed and a '-' in front of them negates them, otherwise decimals are
+ * parsed and signs are ignored.
+ */
+static void scan_numbers(
+    span span,
+    std::string_view s,
+    bool signed_integers,
+    std::vector<object>& out) noexcept
+{
+    const auto* begin = s.data();
+    const auto* end   = s.data() + s.size();
+    const auto* p     = begin;
+
+    for (;;)
+    {
+        p = skip_to_digit(p, end);
+        if (p == end) break;
+
+        double value = 0;
+
+        if (signed_integers)
+        {
+            const auto* start = p > begin && p[-1] == '-' ? p - 1 : p;
+            long long integer = 0;
+            auto result       = std::from_chars(start, end, integer);
+            if (result.ec == std::errc::result_out_of_range)
+            {
+                result = std::from_chars(
+                    start,
+                    end,
+                    value,
+                    std::chars_format::fixed);
+            }
+            else
+            {
+                value = static_cast<double>(integer);
+            }
+            p = result.ptr;
+        }
+        else
+        {
+            auto result
+                = std::from_chars(p, end, value, std::chars_format::fixed);
+            p = result.ptr;
+        }
+
+        out.push_back(create_number(span, value));
+    }
+}
+
 gaya::eval::object::object length(
     interpreter& interp,
     span span,
@@ -228,4 +320,152 @@ trim(interpreter& interp, span span, const std::vector<object>& args) noexcept
 #undef IS_WS
 }
 
+gaya::eval::object::object
+split(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& s       = args[0];
+    auto& pattern = args[1];
+
+    if (!IS_STRING(s) || !IS_STRING(pattern))
+    {
+        interp.interp_error(span, "Expected both arguments to be strings");
+        return invalid;
+    }
+
+    return create_split_sequence(interp, span, s, AS_STRING(pattern));
+}
+
+gaya::eval::object::object split_array(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& s       = args[0];
+    auto& pattern = args[1];
+
+    if (!IS_STRING(s) || !IS_STRING(pattern))
+    {
+        interp.interp_error(span, "Expected both arguments to be strings");
+        return invalid;
+    }
+
+    std::string_view haystack  = AS_STRING(s);
+    std::string_view separator = AS_STRING(pattern);
+    std::vector<object> parts;
+
+    if (separator.empty())
+    {
+        parts.reserve(haystack.size());
+        for (size_t i = 0; i < haystack.size(); i++)
+        {
+            auto c = haystack.substr(i, 1);
+            parts.push_back(create_string(interp, span, c));
+        }
+        return create_array(interp, span, std::move(parts));
+    }
+
+    size_t start = 0;
+    for (;;)
+    {
+        auto end = find_separator(haystack, separator, start);
+        if (end == std::string_view::npos)
+        {
+            auto rest = haystack.substr(start);
+            parts.push_back(create_string(interp, span, rest));
+            break;
+        }
+
+        auto part = haystack.substr(start, end - start);
+        parts.push_back(create_string(interp, span, part));
+        start = end + separator.size();
+    }
+
+    return create_array(interp, span, std::move(parts));
+}
+
+gaya::eval::object::object
+lines(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    auto& s = args[0];
+
+    if (!IS_STRING(s))
+    {
+        interp.interp_error(span, "Expected the first argument to be a string");
+        return invalid;
+    }
+
+    return create_split_sequence(interp, span, s, "\n");
+}
+
+gaya::eval::object::object numbers(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& s = args[0];
+
+    if (!IS_STRING(s))
+    {
+        interp.interp_error(span, "Expected the first argument to be a string");
+        return invalid;
+    }
+
+    std::vector<object> result;
+    scan_numbers(span, AS_STRING(s), false, result);
+
+    return create_array(interp, span, std::move(result));
+}
+
+gaya::eval::object::object integers(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& s = args[0];
+
+    if (!IS_STRING(s))
+    {
+        interp.interp_error(span, "Expected the first argument to be a string");
+        return invalid;
+    }
+
+    std::vector<object> result;
+    scan_numbers(span, AS_STRING(s), true, result);
+
+    return create_array(interp, span, std::move(result));
+}
+
+gaya::eval::object::object integer_lines(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    auto& s = args[0];
+
+    if (!IS_STRING(s))
+    {
+        interp.interp_error(span, "Expected the first argument to be a string");
+        return invalid;
+    }
+
+    std::string_view text = AS_STRING(s);
+    std::vector<object> rows;
+    std::vector<object> row;
+
+    size_t start = 0;
+    while (start < text.size())
+    {
+        auto end = find_separator(text, "\n", start);
+        if (end == std::string_view::npos) end = text.size();
+
+        row.clear();
+        scan_numbers(span, text.substr(start, end - start), true, row);
+        rows.push_back(create_array(interp, span, row));
+
+        start = end + 1;
+    }
+
+    return create_array(interp, span, std::move(rows));
+}
+
 }
@@ -0,0 +1,715 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+#include <fmt/core.h>
+
+#include <builtins/typed.hpp>
+#include <eval.hpp>
+
+namespace gaya::eval::object::builtin::typed
+{
+
+/*
+ * Whole-array operations work on a register of numbers at a time through the
+ * vector extensions of GCC and Clang. Registers are 32 bytes where the
+ * compiler may use AVX and 16 bytes otherwise, so that vectors are never
+ * passed around in a way that depends on AVX being there.
+ */
+#ifdef __AVX__
+static constexpr size_t vector_bytes = 32;
+#else
+static constexpr size_t vector_bytes = 16;
+#endif
+
+template <typename T>
+struct lanes
+{
+    static constexpr size_t width = vector_bytes / sizeof(T);
+    typedef T type __attribute__((vector_size(vector_bytes)));
+};
+
+template <typename T>
+static typename lanes<T>::type load(const T* p) noexcept
+{
+    typename lanes<T>::type v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+template <typename T>
+static void store(T* p, typename lanes<T>::type v) noexcept
+{
+    std::memcpy(p, &v, sizeof v);
+}
+
+/*
+ * Combine the numbers with an associative operation. Two vectors of partial
+ * results are kept, so that a step does not wait on the one before it.
+ */
+template <typename T, typename Op>
+static T fold(const std::vector<T>& xs, T init, Op op) noexcept
+{
+    using vector         = typename lanes<T>::type;
+    constexpr auto width = lanes<T>::width;
+
+    const auto* p = xs.data();
+    auto n        = xs.size();
+
+    vector a = vector {} + init;
+    vector b = a;
+
+    size_t i = 0;
+    for (; i + 2 * width <= n; i += 2 * width)
+    {
+        a = op(a, load(p + i));
+        b = op(b, load(p + i + width));
+    }
+
+    a        = op(a, b);
+    T result = init;
+    for (size_t j = 0; j < width; j++) result = op(result, a[j]);
+    for (; i < n; i++) result = op(result, p[i]);
+
+    return result;
+}
+
+template <typename T>
+static T
+dot_product(const std::vector<T>& xs, const std::vector<T>& ys) noexcept
+{
+    using vector         = typename lanes<T>::type;
+    constexpr auto width = lanes<T>::width;
+
+    const auto* p = xs.data();
+    const auto* q = ys.data();
+    auto n        = xs.size();
+
+    vector a {};
+    vector b {};
+
+    size_t i = 0;
+    for (; i + 2 * width <= n; i += 2 * width)
+    {
+        a += load(p + i) * load(q + i);
+        b += load(p + i + width) * load(q + i + width);
+    }
+
+    a        = a + b;
+    T result = 0;
+    for (size_t j = 0; j < width; j++) result += a[j];
+    for (; i < n; i++) result += p[i] * q[i];
+
+    return result;
+}
+
+/*
+ * Apply an operation to the numbers at the same index in two arrays of the
+ * same length.
+ */
+template <typename T, typename Op>
+static std::vector<T>
+zip_with(const std::vector<T>& xs, const std::vector<T>& ys, Op op) noexcept
+{
+    constexpr auto width = lanes<T>::width;
+
+    auto n = xs.size();
+    std::vector<T> result(n);
+
+    size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        store(result.data() + i, op(load(xs.data() + i), load(ys.data() + i)));
+    }
+    for (; i < n; i++) result[i] = op(xs[i], ys[i]);
+
+    return result;
+}
+
+template <typename T>
+static std::vector<T> scaled(const std::vector<T>& xs, T k) noexcept
+{
+    constexpr auto width = lanes<T>::width;
+
+    auto n = xs.size();
+    std::vector<T> result(n);
+
+    size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        store(result.data() + i, load(xs.data() + i) * k);
+    }
+    for (; i < n; i++) result[i] = xs[i] * k;
+
+    return result;
+}
+
+/*
+ * Int64 arithmetic that would overflow is done on doubles instead, so that
+ * it rounds like the numbers of a regular array rather than wrapping. Sums
+ * are added in unsigned lanes, where wrapping is defined, while keeping the
+ * sign bits of the lanes that went past the range of int64.
+ */
+using int64_lanes = lanes<uint64_t>::type;
+
+static inline int64_lanes load_int64s(const int64_t* p) noexcept
+{
+    return load(reinterpret_cast<const uint64_t*>(p));
+}
+
+static inline int64_lanes
+overflows(int64_lanes x, int64_lanes y, int64_lanes sum) noexcept
+{
+    return (x ^ sum) & (y ^ sum);
+}
+
+static inline bool any_overflow(int64_lanes overflow) noexcept
+{
+    uint64_t bits = 0;
+    for (size_t j = 0; j < lanes<uint64_t>::width; j++) bits |= overflow[j];
+    return bits >> 63;
+}
+
+static std::optional<int64_t>
+checked_sum(const std::vector<int64_t>& xs) noexcept
+{
+    constexpr auto width = lanes<uint64_t>::width;
+
+    const auto* p = xs.data();
+    auto n        = xs.size();
+
+    int64_lanes a {};
+    int64_lanes overflow {};
+
+    size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        auto x = load_int64s(p + i);
+        auto r = a + x;
+        overflow |= overflows(a, x, r);
+        a = r;
+    }
+
+    int64_t total = 0;
+    bool failed   = any_overflow(overflow);
+    for (size_t j = 0; j < width; j++)
+    {
+        failed |= __builtin_add_overflow(total, a[j], &total);
+    }
+    for (; i < n; i++) failed |= __builtin_add_overflow(total, p[i], &total);
+
+    if (!failed) return total;
+
+    /* A lane can overflow when the total does not, so add them one by one. */
+    total = 0;
+    for (auto x : xs)
+    {
+        if (__builtin_add_overflow(total, x, &total)) return std::nullopt;
+    }
+
+    return total;
+}
+
+/*
+ * Products have no cheap check in vector lanes, so the ones below go one
+ * number at a time.
+ */
+static std::optional<int64_t> checked_dot_product(
+    const std::vector<int64_t>& xs,
+    const std::vector<int64_t>& ys) noexcept
+{
+    int64_t total = 0;
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        int64_t product;
+        if (__builtin_mul_overflow(xs[i], ys[i], &product)
+            || __builtin_add_overflow(total, product, &total))
+        {
+            return std::nullopt;
+        }
+    }
+
+    return total;
+}
+
+static std::optional<std::vector<int64_t>> checked_sums(
+    const std::vector<int64_t>& xs,
+    const std::vector<int64_t>& ys) noexcept
+{
+    constexpr auto width = lanes<uint64_t>::width;
+
+    auto n = xs.size();
+    std::vector<int64_t> result(n);
+    int64_lanes overflow {};
+
+    size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        auto x = load_int64s(xs.data() + i);
+        auto y = load_int64s(ys.data() + i);
+        auto r = x + y;
+        overflow |= overflows(x, y, r);
+        store(reinterpret_cast<uint64_t*>(result.data()) + i, r);
+    }
+
+    bool failed = any_overflow(overflow);
+    for (; i < n; i++)
+    {
+        failed |= __builtin_add_overflow(xs[i], ys[i], &result[i]);
+    }
+
+    if (failed) return std::nullopt;
+    return result;
+}
+
+static std::optional<std::vector<int64_t>> checked_products(
+    const std::vector<int64_t>& xs,
+    const std::vector<int64_t>& ys) noexcept
+{
+    std::vector<int64_t> result(xs.size());
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        if (__builtin_mul_overflow(xs[i], ys[i], &result[i]))
+        {
+            return std::nullopt;
+        }
+    }
+
+    return result;
+}
+
+static std::optional<std::vector<int64_t>>
+checked_scaled(const std::vector<int64_t>& xs, int64_t k) noexcept
+{
+    std::vector<int64_t> result(xs.size());
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        if (__builtin_mul_overflow(xs[i], k, &result[i])) return std::nullopt;
+    }
+
+    return result;
+}
+
+static constexpr auto plus = [](auto x, auto y) {
+    return x + y;
+};
+
+static constexpr auto times = [](auto x, auto y) {
+    return x * y;
+};
+
+static constexpr auto smaller = [](auto x, auto y) {
+    return x < y ? x : y;
+};
+
+static constexpr auto larger = [](auto x, auto y) {
+    return x > y ? x : y;
+};
+
+/*
+ * Check that the argument at the given position is a typed array, reporting
+ * an error if it is not.
+ */
+static bool expect_typed_array(
+    interpreter& interp,
+    span span,
+    const object& o,
+    const char* position) noexcept
+{
+    if (IS_TYPED_ARRAY(o)) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format(
+            "Expected the {} argument to be a typed array, but got {}",
+            position,
+            typeof_(o)));
+    return false;
+}
+
+static bool expect_same_length(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return false;
+    if (!expect_typed_array(interp, span, args[1], "second")) return false;
+
+    auto a = AS_TYPED_ARRAY(args[0]).size();
+    auto b = AS_TYPED_ARRAY(args[1]).size();
+    if (a == b) return true;
+
+    interp.interp_error(
+        span,
+        fmt::format(
+            "Expected arrays of the same length, but got {} and {}",
+            a,
+            b));
+    return false;
+}
+
+static bool is_int64(const typed_array& array) noexcept
+{
+    return array.element_kind() == typed_array::kind::int64;
+}
+
+/*
+ * Whether a number can be kept in an Int64Array without changing it.
+ */
+static bool fits_int64(double x) noexcept
+{
+    return std::trunc(x) == x && x >= -0x1p63 && x < 0x1p63;
+}
+
+static std::vector<double> as_float64s(const typed_array& array) noexcept
+{
+    if (!is_int64(array)) return array.float64s();
+
+    const auto& xs = array.int64s();
+    return { xs.begin(), xs.end() };
+}
+
+/*
+ * Collect the numbers of a sequence or of another typed array into a typed
+ * array of the given kind.
+ */
+static object make(
+    interpreter& interp,
+    span span,
+    const object& o,
+    typed_array::kind kind) noexcept
+{
+    if (!is_sequence(o))
+    {
+        interp.interp_error(
+            span,
+            fmt::format("Expected a sequence, but got {}", typeof_(o)));
+        return invalid;
+    }
+
+    auto result = typed_array { span, kind };
+    if (auto size = exact_size(o); size)
+    {
+        if (kind == typed_array::kind::float64)
+        {
+            result.float64s().reserve(*size);
+        }
+        else
+        {
+            result.int64s().reserve(*size);
+        }
+    }
+
+    auto xs     = o;
+    auto seq    = to_sequence(interp, xs);
+    auto reader = sequence_reader { interp, span, seq, can_prefetch(seq) };
+
+    for (;;)
+    {
+        auto x = reader.next();
+        if (!is_valid(x)) return invalid;
+        if (IS_UNIT(x)) break;
+
+        if (!IS_NUMBER(x))
+        {
+            interp.interp_error(
+                span,
+                fmt::format("Expected {} to be a Number", typeof_(x)));
+            return invalid;
+        }
+
+        auto n = AS_NUMBER(x);
+        if (kind == typed_array::kind::int64 && !fits_int64(n))
+        {
+            interp.interp_error(
+                span,
+                fmt::format("Expected a whole number, but got {}", n));
+            return invalid;
+        }
+
+        result.push_back(n);
+    }
+
+    return create_typed_array(interp, span, std::move(result));
+}
+
+/* typed.float64 */
+
+gaya::eval::object::object float64(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    return make(interp, span, args[0], typed_array::kind::float64);
+}
+
+/* typed.int64 */
+
+gaya::eval::object::object
+int64(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return make(interp, span, args[0], typed_array::kind::int64);
+}
+
+/* typed.length */
+
+gaya::eval::object::object
+length(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    return create_number(span, AS_TYPED_ARRAY(args[0]).size());
+}
+
+/* typed.sum */
+
+gaya::eval::object::object
+sum(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+    if (!is_int64(a)) return create_number(span, fold(a.float64s(), 0.0, plus));
+
+    if (auto total = checked_sum(a.int64s()); total)
+    {
+        return create_number(span, static_cast<double>(*total));
+    }
+
+    return create_number(span, fold(as_float64s(a), 0.0, plus));
+}
+
+/*
+ * The smallest or the largest number, found by folding from the first one.
+ */
+template <typename Op>
+static object extreme(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args,
+    Op op) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+    if (a.empty()) return create_unit(span);
+
+    if (is_int64(a))
+    {
+        const auto& xs = a.int64s();
+        return create_number(span, static_cast<double>(fold(xs, xs[0], op)));
+    }
+
+    const auto& xs = a.float64s();
+    return create_number(span, fold(xs, xs[0], op));
+}
+
+/* typed.min */
+
+gaya::eval::object::object
+min(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return extreme(interp, span, args, smaller);
+}
+
+/* typed.max */
+
+gaya::eval::object::object
+max(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return extreme(interp, span, args, larger);
+}
+
+/* typed.dot */
+
+gaya::eval::object::object
+dot(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_same_length(interp, span, args)) return invalid;
+
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+    const auto& b = AS_TYPED_ARRAY(args[1]);
+    if (is_int64(a) && is_int64(b))
+    {
+        if (auto total = checked_dot_product(a.int64s(), b.int64s()); total)
+        {
+            return create_number(span, static_cast<double>(*total));
+        }
+    }
+    else if (!is_int64(a) && !is_int64(b))
+    {
+        return create_number(span, dot_product(a.float64s(), b.float64s()));
+    }
+
+    return create_number(span, dot_product(as_float64s(a), as_float64s(b)));
+}
+
+/* typed.prefixSum */
+
+gaya::eval::object::object prefix_sum(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    /* Each total depends on the one before it, so this is a plain scan. */
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+    if (is_int64(a))
+    {
+        auto result = a;
+        auto& xs    = result.int64s();
+
+        size_t i = 1;
+        for (; i < xs.size(); i++)
+        {
+            if (__builtin_add_overflow(xs[i], xs[i - 1], &xs[i])) break;
+        }
+
+        if (i >= xs.size())
+        {
+            return create_typed_array(interp, span, std::move(result));
+        }
+    }
+
+    auto result       = typed_array { span, typed_array::kind::float64 };
+    result.float64s() = as_float64s(a);
+
+    auto& xs = result.float64s();
+    for (size_t i = 1; i < xs.size(); i++) xs[i] += xs[i - 1];
+
+    return create_typed_array(interp, span, std::move(result));
+}
+
+/*
+ * Apply an operation elementwise to two typed arrays, keeping int64s if both
+ * arrays have them and none of the results overflows.
+ */
+template <typename Op, typename Checked>
+static object elementwise(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args,
+    Op op,
+    Checked checked) noexcept
+{
+    if (!expect_same_length(interp, span, args)) return invalid;
+
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+    const auto& b = AS_TYPED_ARRAY(args[1]);
+    if (is_int64(a) && is_int64(b))
+    {
+        if (auto xs = checked(a.int64s(), b.int64s()); xs)
+        {
+            auto result     = typed_array { span, typed_array::kind::int64 };
+            result.int64s() = std::move(*xs);
+            return create_typed_array(interp, span, std::move(result));
+        }
+    }
+
+    auto result = typed_array { span, typed_array::kind::float64 };
+    if (!is_int64(a) && !is_int64(b))
+    {
+        result.float64s() = zip_with(a.float64s(), b.float64s(), op);
+    }
+    else
+    {
+        result.float64s() = zip_with(as_float64s(a), as_float64s(b), op);
+    }
+
+    return create_typed_array(interp, span, std::move(result));
+}
+
+/* typed.add */
+
+gaya::eval::object::object
+add(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return elementwise(interp, span, args, plus, checked_sums);
+}
+
+/* typed.mul */
+
+gaya::eval::object::object
+mul(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    return elementwise(interp, span, args, times, checked_products);
+}
+
+/* typed.scale */
+
+gaya::eval::object::object
+scale(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    if (!IS_NUMBER(args[1]))
+    {
+        interp.interp_error(
+            span,
+            "Expected the second argument to be a number");
+        return invalid;
+    }
+
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+    auto k        = AS_NUMBER(args[1]);
+    if (is_int64(a) && fits_int64(k))
+    {
+        auto xs = checked_scaled(a.int64s(), static_cast<int64_t>(k));
+        if (xs)
+        {
+            auto result     = typed_array { span, typed_array::kind::int64 };
+            result.int64s() = std::move(*xs);
+            return create_typed_array(interp, span, std::move(result));
+        }
+    }
+
+    auto result = typed_array { span, typed_array::kind::float64 };
+    result.float64s()
+        = is_int64(a) ? scaled(as_float64s(a), k) : scaled(a.float64s(), k);
+    return create_typed_array(interp, span, std::move(result));
+}
+
+/* typed.sort */
+
+gaya::eval::object::object
+sort(interpreter& interp, span span, const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    auto& a = AS_TYPED_ARRAY(args[0]);
+    if (is_int64(a))
+    {
+        std::sort(a.int64s().begin(), a.int64s().end());
+    }
+    else
+    {
+        std::sort(a.float64s().begin(), a.float64s().end());
+    }
+
+    return args[0];
+}
+
+/* typed.toArray */
+
+gaya::eval::object::object to_array(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!expect_typed_array(interp, span, args[0], "first")) return invalid;
+
+    const auto& a = AS_TYPED_ARRAY(args[0]);
+
+    std::vector<object> elems;
+    elems.reserve(a.size());
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        elems.push_back(create_number(span, a.at(i)));
+    }
+
+    return create_array(interp, span, elems);
+}
+
+}
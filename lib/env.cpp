@@ -1,6 +1,7 @@
 #include <fmt/core.h>
 
 #include "env.hpp"
+#include <generator.hpp>
 #include <object.hpp>
 
 namespace gaya::eval
@@ -46,16 +47,35 @@ env::env(parent_ptr p)
 {
 }
 
-env env::deep_copy(interpreter& interp, span span) const noexcept
+bool env::can_change() const noexcept
 {
-    env new_env {
-        _parent ? std::make_shared<env>(_parent->deep_copy(interp, span))
-                : _parent,
-    };
+    for (const auto& [k, o] : _bindings)
+    {
+        if (k.is_assignment_target() || IS_SEQUENCE(o)) return true;
+    }
+
+    return false;
+}
+
+/*
+ * Whether a sequence can be copied. A generator that has started cannot, so
+ * forks share it instead.
+ */
+static bool can_copy(const object::object& o) noexcept
+{
+    const auto* generator_seq
+        = std::get_if<object::generator_sequence>(&AS_SEQUENCE(o).seq);
+    return !generator_seq || !generator_seq->state->started();
+}
+
+env env::fork_frame(parent_ptr parent, interpreter& interp, span span)
+    const noexcept
+{
+    env new_env { std::move(parent) };
 
     for (auto [k, o] : _bindings)
     {
-        if (IS_SEQUENCE(o))
+        if (IS_SEQUENCE(o) && can_copy(o))
         {
             new_env.set(
                 std::move(k),
@@ -70,6 +90,28 @@ env env::deep_copy(interpreter& interp, span span) const noexcept
     return new_env;
 }
 
+env::parent_ptr env::fork_chain(
+    const parent_ptr& environment,
+    interpreter& interp,
+    span span) noexcept
+{
+    if (!environment) return environment;
+
+    auto parent = fork_chain(environment->_parent, interp, span);
+    if (parent == environment->_parent && !environment->can_change())
+    {
+        return environment;
+    }
+
+    return std::make_shared<env>(
+        environment->fork_frame(std::move(parent), interp, span));
+}
+
+env env::fork(interpreter& interp, span span) const noexcept
+{
+    return fork_frame(fork_chain(_parent, interp, span), interp, span);
+}
+
 void env::set(key&& k, value_type v) noexcept
 {
     _bindings.insert_or_assign(std::move(k), v);
@@ -6,13 +6,20 @@
 #include <builtins/aoc.hpp>
 #include <builtins/array.hpp>
 #include <builtins/core.hpp>
+#include <builtins/deque.hpp>
 #include <builtins/dict.hpp>
+#include <builtins/grid.hpp>
 #include <builtins/io.hpp>
 #include <builtins/math.hpp>
+#include <builtins/pq.hpp>
+#include <builtins/re.hpp>
 #include <builtins/sequence.hpp>
+#include <builtins/set.hpp>
 #include <builtins/string.hpp>
+#include <builtins/typed.hpp>
 #include <eval.hpp>
 #include <file_reader.hpp>
+#include <generator.hpp>
 #include <parser.hpp>
 #include <resolver.hpp>
 #include <span.hpp>
@@ -60,12 +67,18 @@ interpreter::interpreter(
     BUILTIN("tosequence"s, 1, core::tosequence);
     BUILTIN("issequence"s, 1, core::issequence);
     BUILTIN("md5"s, 1, core::md5);
+    BUILTIN("tuple"s, 1, core::tuple_);
 
     BUILTIN("io.println"s, 1, io::println);
     BUILTIN("io.print"s, 1, io::print);
     BUILTIN("io.readline"s, 0, io::readline);
+    BUILTIN("io.stdin"s, 0, io::stdin_);
+    BUILTIN("io.stdinChunks"s, 0, io::stdin_chunks);
     BUILTIN("io.readfile"s, 1, io::readfile);
+    BUILTIN("io.lines"s, 1, io::lines);
     BUILTIN("io.listdir"s, 1, io::listdir);
+    BUILTIN("io.flush"s, 0, io::flush);
+    BUILTIN("io.setBufferSize"s, 1, io::set_buffer_size);
 
     BUILTIN("string.length"s, 1, string::length);
     BUILTIN("string.concat"s, 2, string::concat);
@@ -75,6 +88,12 @@ interpreter::interpreter(
     BUILTIN("string.startswith"s, 3, string::startswith);
     BUILTIN("string.endswith"s, 2, string::endswith);
     BUILTIN("string.trim"s, 1, string::trim);
+    BUILTIN("string.split"s, 2, string::split);
+    BUILTIN("string.splitArray"s, 2, string::split_array);
+    BUILTIN("string.lines"s, 1, string::lines);
+    BUILTIN("string.numbers"s, 1, string::numbers);
+    BUILTIN("string.integers"s, 1, string::integers);
+    BUILTIN("string.integerLines"s, 1, string::integer_lines);
 
     BUILTIN("array.length"s, 1, array::length);
     BUILTIN("array.concat"s, 2, array::concat);
@@ -82,19 +101,113 @@ interpreter::interpreter(
     BUILTIN("array.pop"s, 1, array::pop);
     BUILTIN("array.sort"s, 2, array::sort);
     BUILTIN("array.set"s, 3, array::set);
+    BUILTIN("array.slice"s, 3, array::slice);
+    BUILTIN("array.clone"s, 1, array::clone);
 
     BUILTIN("dict.length"s, 1, dict::length);
     BUILTIN("dict.set"s, 3, dict::set);
     BUILTIN("dict.remove"s, 2, dict::remove);
+    BUILTIN("dict.update"s, 4, dict::update);
+    BUILTIN("dict.increment"s, 3, dict::increment);
+    BUILTIN("dict.getOrInsert"s, 3, dict::get_or_insert);
+    BUILTIN("dict.pop"s, 3, dict::pop);
     BUILTIN("dict.contains"s, 2, dict::contains);
+    BUILTIN("dict.keys"s, 1, dict::keys);
+    BUILTIN("dict.values"s, 1, dict::values);
+    BUILTIN("dict.items"s, 1, dict::items);
+    BUILTIN("dict.clone"s, 1, dict::clone);
+
+    BUILTIN("set"s, 1, set::make);
+    BUILTIN("set.length"s, 1, set::length);
+    BUILTIN("set.add"s, 2, set::add);
+    BUILTIN("set.remove"s, 2, set::remove);
+    BUILTIN("set.contains"s, 2, set::contains);
+    BUILTIN("set.union"s, 2, set::union_);
+    BUILTIN("set.intersection"s, 2, set::intersection);
+    BUILTIN("set.difference"s, 2, set::difference);
+
+    BUILTIN("pq.new"s, 0, pq::make);
+    BUILTIN("pq.length"s, 1, pq::length);
+    BUILTIN("pq.push"s, 3, pq::push);
+    BUILTIN("pq.pop"s, 1, pq::pop);
+    BUILTIN("pq.peek"s, 1, pq::peek);
+    BUILTIN("pq.priority"s, 1, pq::priority);
+    BUILTIN("pq.decrease"s, 3, pq::decrease);
+
+    BUILTIN("deque"s, 1, deque::make);
+    BUILTIN("deque.length"s, 1, deque::length);
+    BUILTIN("deque.pushFront"s, 2, deque::push_front);
+    BUILTIN("deque.pushBack"s, 2, deque::push_back);
+    BUILTIN("deque.popFront"s, 1, deque::pop_front);
+    BUILTIN("deque.popBack"s, 1, deque::pop_back);
+
+    BUILTIN("grid.new"s, 3, grid::make);
+    BUILTIN("grid.fromString"s, 1, grid::from_string);
+    BUILTIN("grid.width"s, 1, grid::width);
+    BUILTIN("grid.height"s, 1, grid::height);
+    BUILTIN("grid.get"s, 2, grid::get);
+    BUILTIN("grid.set"s, 3, grid::set);
+    BUILTIN("grid.neighbours"s, 2, grid::neighbours);
+    BUILTIN("grid.neighbours8"s, 2, grid::neighbours8);
+    BUILTIN("grid.row"s, 2, grid::row);
+    BUILTIN("grid.column"s, 2, grid::column);
+    BUILTIN("grid.find"s, 2, grid::find);
+    BUILTIN("grid.findAll"s, 2, grid::find_all);
+    BUILTIN("grid.floodFill"s, 2, grid::flood_fill);
+    BUILTIN("grid.copy"s, 1, grid::copy);
+
+    BUILTIN("typed.float64"s, 1, typed::float64);
+    BUILTIN("typed.int64"s, 1, typed::int64);
+    BUILTIN("typed.length"s, 1, typed::length);
+    BUILTIN("typed.sum"s, 1, typed::sum);
+    BUILTIN("typed.min"s, 1, typed::min);
+    BUILTIN("typed.max"s, 1, typed::max);
+    BUILTIN("typed.dot"s, 2, typed::dot);
+    BUILTIN("typed.prefixSum"s, 1, typed::prefix_sum);
+    BUILTIN("typed.add"s, 2, typed::add);
+    BUILTIN("typed.mul"s, 2, typed::mul);
+    BUILTIN("typed.scale"s, 2, typed::scale);
+    BUILTIN("typed.sort"s, 1, typed::sort);
+    BUILTIN("typed.toArray"s, 1, typed::to_array);
 
     BUILTIN("seq.next"s, 1, sequence::next);
     BUILTIN("seq.make"s, 1, sequence::make);
     BUILTIN("seq.copy"s, 1, sequence::copy);
+    BUILTIN("seq.range"s, 2, sequence::range);
+    BUILTIN("seq.map"s, 2, sequence::map);
+    BUILTIN("seq.filter"s, 2, sequence::filter);
+    BUILTIN("seq.take"s, 2, sequence::take);
+    BUILTIN("seq.drop"s, 2, sequence::drop);
+    BUILTIN("seq.takewhile"s, 2, sequence::takewhile);
+    BUILTIN("seq.dropwhile"s, 2, sequence::dropwhile);
+    BUILTIN("seq.enumerate"s, 1, sequence::enumerate);
+    BUILTIN("seq.flatten"s, 1, sequence::flatten);
+    BUILTIN("seq.concatMap"s, 2, sequence::concat_map);
+    BUILTIN("seq.foreach"s, 2, sequence::for_each);
+    BUILTIN("seq.reduce"s, 3, sequence::reduce);
+    BUILTIN("seq.sum"s, 1, sequence::sum);
+    BUILTIN("seq.count"s, 1, sequence::count);
+    BUILTIN("seq.groupBy"s, 2, sequence::group_by);
+    BUILTIN("seq.countBy"s, 2, sequence::count_by);
+    BUILTIN("seq.histogram"s, 1, sequence::histogram);
+    BUILTIN("seq.unique"s, 1, sequence::unique);
+    BUILTIN("seq.any"s, 2, sequence::any);
+    BUILTIN("seq.all"s, 2, sequence::all);
+    BUILTIN("seq.min"s, 1, sequence::min);
+    BUILTIN("seq.max"s, 1, sequence::max);
+    BUILTIN("seq.toarray"s, 1, sequence::toarray);
+    BUILTIN("seq.inits"s, 1, sequence::inits);
+    BUILTIN("seq.tails"s, 1, sequence::tails);
+    BUILTIN("seq.tee"s, 2, sequence::tee);
 
     BUILTIN("math.floor"s, 1, math::floor);
     BUILTIN("math.ceil"s, 1, math::ceil);
 
+    BUILTIN("re.match"s, 2, re::match);
+    BUILTIN("re.findall"s, 2, re::findall);
+    BUILTIN("re.captures"s, 2, re::captures);
+    BUILTIN("re.split"s, 2, re::split);
+
     BUILTIN("aoc.getInput"s, 3, aoc::get_input);
 
     /* Set up command line arguments. */
@@ -118,6 +231,11 @@ parser& interpreter::get_parser() noexcept
     return _parser;
 }
 
+output_buffer& interpreter::output() noexcept
+{
+    return _output;
+}
+
 std::optional<object::object>
 interpreter::eval(const std::string& filename, const char* source) noexcept
 {
@@ -177,6 +295,8 @@ const std::string& interpreter::current_filename() const noexcept
 
 void interpreter::report_diagnostics() noexcept
 {
+    _output.flush();
+
     for (const auto& diagnostic : _diagnostics)
     {
         fmt::println("{}", diagnostic.to_string());
@@ -209,6 +329,37 @@ const std::vector<env>& interpreter::scopes() const noexcept
     return _scopes;
 }
 
+execution_mark interpreter::resume_execution(
+    generator& generator,
+    execution_context& context) noexcept
+{
+    auto mark = execution_mark { _scopes.size(), _generator };
+
+    _scopes.insert(
+        _scopes.end(),
+        std::make_move_iterator(context.scopes.begin()),
+        std::make_move_iterator(context.scopes.end()));
+    context.scopes.clear();
+    _generator = &generator;
+
+    return mark;
+}
+
+void interpreter::suspend_execution(
+    const execution_mark& mark,
+    execution_context& context) noexcept
+{
+    assert(_scopes.size() >= mark.scopes);
+
+    auto first = _scopes.begin() + static_cast<ptrdiff_t>(mark.scopes);
+    context.scopes.assign(
+        std::make_move_iterator(first),
+        std::make_move_iterator(_scopes.end()));
+
+    _scopes.erase(first, _scopes.end());
+    _generator = mark.running;
+}
+
 env& interpreter::environment() noexcept
 {
     return _scopes.back();
@@ -311,7 +462,7 @@ object::object interpreter::assign_to_call_expression(
     if (IS_DICTIONARY(target))
     {
         auto& d = AS_DICT(target);
-        d.insert_or_assign(index, value);
+        d.insert_or_assign(*this, index, value);
         return object::invalid;
     }
 
@@ -319,7 +470,7 @@ object::object interpreter::assign_to_call_expression(
     {
         auto& a = AS_ARRAY(target);
         auto i  = AS_NUMBER(index);
-        a[i]    = value;
+        a.set(i, value);
         return object::invalid;
     }
 
@@ -345,7 +496,7 @@ object::object interpreter::assign_to_get_expression(
             *this,
             get_expression.span_,
             get_expression.ident.value);
-        dict.insert_or_assign(key, value);
+        dict.insert_or_assign(*this, key, value);
         return object::invalid;
     }
 
@@ -456,53 +607,326 @@ object::object interpreter::visit_while_stmt(ast::while_stmt& while_stmt)
     return object::invalid;
 }
 
-object::object interpreter::visit_for_in_stmt(ast::for_in_stmt& for_)
+/*
+ * Runs the body of a for loop with its variables bound to given values.
+ *
+ * Only the loop variables are ever defined in the scope of the loop, so their
+ * bindings are created on the first iteration and then written in place.
+ */
+class for_loop_body final
 {
-    begin_scope(env { std::make_shared<env>(environment()) });
+public:
+    for_loop_body(interpreter& interp, ast::for_in_stmt& for_) noexcept
+        : _interp { interp }
+        , _for { for_ }
+    {
+    }
 
-    auto o = for_.sequence->accept(*this);
-    if (!object::is_valid(o))
+    /// Run the body once, returning false if it produced an error.
+    [[nodiscard]] bool run(object::object value) noexcept
     {
-        end_scope();
-        return object::invalid;
+        if (!_for.value_ident)
+        {
+            bind(value, object::invalid);
+            return run_body();
+        }
+
+        if (IS_TUPLE(value) && AS_TUPLE(value).size() == 2)
+        {
+            const auto& pair = AS_TUPLE(value);
+            bind(pair[0], pair[1]);
+            return run_body();
+        }
+
+        if (!IS_ARRAY(value) || AS_ARRAY(value).size() != 2)
+        {
+            _interp.interp_error(
+                _for.span_,
+                "for-loop expected a key-value pair to destructure");
+            return false;
+        }
+
+        const auto& pair = AS_ARRAY(value);
+        bind(pair[0], pair[1]);
+        return run_body();
+    }
+
+    /// Run the body once for a dictionary entry.
+    [[nodiscard]] bool run(object::object key, object::object value) noexcept
+    {
+        if (!_for.value_ident)
+        {
+            std::vector<object::object> pair { key, value };
+            bind(object::create_array(_interp, _for.span_, pair), value);
+        }
+        else
+        {
+            bind(key, value);
+        }
+
+        return run_body();
+    }
+
+private:
+    interpreter& _interp;
+    ast::for_in_stmt& _for;
+    env* _scope                 = nullptr;
+    object::object* _key_slot   = nullptr;
+    object::object* _value_slot = nullptr;
+
+    void bind(object::object key, object::object value) noexcept
+    {
+        /*
+         * NOTE: Scopes are stored by value, so the loop's own scope moves if
+         *       the body pushes enough nested ones to grow the scope stack.
+         */
+        if (auto* scope = &_interp.environment(); scope != _scope)
+        {
+            _interp.define(_for.ident->key, key);
+            if (_for.value_ident) _interp.define(_for.value_ident->key, value);
+
+            auto& bindings = scope->get_bindings();
+            _scope         = scope;
+            _key_slot      = &bindings.find(_for.ident->key)->second;
+
+            if (_for.value_ident)
+            {
+                _value_slot = &bindings.find(_for.value_ident->key)->second;
+            }
+        }
+        else
+        {
+            *_key_slot = key;
+            if (_value_slot) *_value_slot = value;
+        }
+    }
+
+    [[nodiscard]] bool run_body() noexcept
+    {
+        for (auto& stmt : _for.body)
+        {
+            stmt->accept(_interp);
+            if (_interp.had_error()) return false;
+        }
+
+        return true;
+    }
+};
+
+/*
+ * Evaluate the bounds of an upto expression, reporting an error if they are
+ * not numbers.
+ */
+static bool evaluate_upto(
+    interpreter& interp,
+    ast::Upto& upto,
+    double& start,
+    double& end) noexcept
+{
+    auto start_object = upto.start->accept(interp);
+    if (!object::is_valid(start_object)) return false;
+
+    if (!IS_NUMBER(start_object))
+    {
+        interp.interp_error(upto.span_, "upto expected start to be a number");
+        return false;
+    }
+
+    auto end_object = upto.end->accept(interp);
+    if (!object::is_valid(end_object)) return false;
+
+    if (!IS_NUMBER(end_object))
+    {
+        interp.interp_error(upto.span_, "upto expected end to be a number");
+        return false;
+    }
+
+    start = AS_NUMBER(start_object);
+    end   = AS_NUMBER(end_object);
+    return true;
+}
+
+/*
+ * Loop over the numbers from start to end, without creating a sequence.
+ */
+static bool run_counted_loop(
+    for_loop_body& body,
+    span span,
+    double start,
+    double end) noexcept
+{
+    for (double i = start; i < end; i++)
+    {
+        if (!body.run(object::create_number(span, i))) return false;
+    }
+
+    return true;
+}
+
+/*
+ * Evaluate the iteratee of a for loop and run the loop over it, returning
+ * false if an error happened.
+ */
+static bool run_for_in(
+    interpreter& interp,
+    ast::for_in_stmt& for_,
+    for_loop_body& body) noexcept
+{
+    /*
+     * Arrays, numbers, ranges and strings are iterated directly, so that no
+     * sequence object needs to be allocated for them.
+     */
+    if (auto* upto = dynamic_cast<ast::Upto*>(for_.sequence.get()); upto)
+    {
+        double start, end;
+        if (!evaluate_upto(interp, *upto, start, end)) return false;
+
+        return run_counted_loop(body, upto->span_, start, end);
     }
 
+    auto o = for_.sequence->accept(interp);
+    if (!object::is_valid(o)) return false;
+
     if (!object::is_sequence(o))
     {
-        interp_error(for_.span_, "for-loops can only be used with sequences");
-        end_scope();
-        return object::invalid;
+        interp.interp_error(
+            for_.span_,
+            "for-loops can only be used with sequences");
+        return false;
     }
 
-    auto sequence = object::to_sequence(*this, o);
-    auto& ident   = for_.ident;
+    switch (o.type)
+    {
+    case object::object_type_number:
+    {
+        return run_counted_loop(body, o.span, 0, AS_NUMBER(o));
+    }
+    case object::object_type_array:
+    {
+        /* The array may grow while it is iterated, so it is indexed afresh on
+         * every iteration. */
+        for (size_t i = 0; i < AS_ARRAY(o).size(); i++)
+        {
+            if (!body.run(AS_ARRAY(o)[i])) return false;
+        }
 
-    for (;;)
+        return true;
+    }
+    case object::object_type_tuple:
     {
-        auto next = object::next(*this, AS_SEQUENCE(sequence));
-        if (!object::is_valid(next))
+        const auto& t = AS_TUPLE(o);
+        for (size_t i = 0; i < t.size(); i++)
         {
-            end_scope();
-            return object::invalid;
+            if (!body.run(t[i])) return false;
         }
 
-        if (next.type == object::object_type_unit)
+        return true;
+    }
+    case object::object_type_deque:
+    {
+        /* Like arrays, deques are indexed afresh, since the body may push or
+         * pop elements. */
+        const auto& deque = AS_DEQUE(o);
+        for (size_t i = 0; i < deque.size(); i++)
         {
-            break;
+            if (!body.run(deque[i])) return false;
         }
 
-        define(ident->key, next);
+        return true;
+    }
+    case object::object_type_typed_array:
+    {
+        const auto& array = AS_TYPED_ARRAY(o);
+        for (size_t i = 0; i < array.size(); i++)
+        {
+            if (!body.run(object::create_number(o.span, array.at(i))))
+            {
+                return false;
+            }
+        }
 
-        for (auto& stmt : for_.body)
+        return true;
+    }
+    case object::object_type_string:
+    {
+        /* Strings are immutable, so a view over the characters is safe. */
+        std::string_view s = AS_STRING(o);
+        for (size_t i = 0; i < s.size(); i++)
         {
-            stmt->accept(*this);
-            if (had_error())
+            auto c = object::create_string(interp, o.span, s.substr(i, 1));
+            if (!body.run(c)) return false;
+        }
+
+        return true;
+    }
+    case object::object_type_dictionary:
+    {
+        /* Entries are bound straight from the table, without pair arrays. */
+        const auto& dict   = AS_DICT(o);
+        const auto changes = dict.changes();
+
+        for (const auto& [key, value] : dict)
+        {
+            if (!body.run(key, value)) return false;
+
+            if (dict.changes() != changes)
             {
-                end_scope();
-                return object::invalid;
+                interp.interp_error(
+                    for_.span_,
+                    "Dictionary changed during iteration");
+                return false;
+            }
+        }
+
+        return true;
+    }
+    case object::object_type_set:
+    {
+        const auto& set    = AS_SET(o);
+        const auto changes = set.changes();
+
+        for (const auto& x : set)
+        {
+            if (!body.run(x)) return false;
+
+            if (set.changes() != changes)
+            {
+                interp.interp_error(
+                    for_.span_,
+                    "Set changed during iteration");
+                return false;
             }
         }
+
+        return true;
     }
+    default: break;
+    }
+
+    auto sequence = object::to_sequence(interp, o);
+    auto reader   = object::sequence_reader {
+        interp,
+        for_.span_,
+        sequence,
+        object::can_read_ahead(o, sequence),
+    };
+
+    for (;;)
+    {
+        auto next = reader.next();
+        if (!object::is_valid(next)) return false;
+        if (IS_UNIT(next)) return true;
+
+        if (!body.run(next)) return false;
+    }
+}
+
+object::object interpreter::visit_for_in_stmt(ast::for_in_stmt& for_)
+{
+    begin_scope(env { std::make_shared<env>(environment()) });
+
+    auto body = for_loop_body { *this, for_ };
+    UNUSED(run_for_in(*this, for_, body));
 
     end_scope();
     return object::invalid;
@@ -687,20 +1111,29 @@ bool interpreter::match_pattern(
     }
     case ast::match_pattern::kind::array_pattern:
     {
-        if (!IS_ARRAY(target)) return false;
+        if (!IS_ARRAY(target) && !IS_TUPLE(target)) return false;
+
+        /* Tuples match the same patterns as arrays with their elements. */
+        auto size = [&] {
+            return IS_ARRAY(target) ? AS_ARRAY(target).size()
+                                    : AS_TUPLE(target).size();
+        };
 
-        auto a               = AS_ARRAY(target);
         using match_patterns = std::vector<ast::match_pattern>;
-        auto patterns        = std::get<match_patterns>(pattern.value);
+        const auto& patterns = std::get<match_patterns>(pattern.value);
 
-        if (a.size() != patterns.size()) return false;
+        if (size() != patterns.size()) return false;
 
-        for (size_t i = 0; i < a.size(); i++)
+        /* Patterns may evaluate expressions that change the array, so its
+         * elements are read afresh instead of copying it. */
+        for (size_t i = 0; i < patterns.size(); i++)
         {
-            auto elem    = a[i];
-            auto pattern = patterns[i];
+            if (size() != patterns.size()) return false;
+
+            auto elem = IS_ARRAY(target) ? AS_ARRAY(target)[i]
+                                         : AS_TUPLE(target)[i];
 
-            if (!match_pattern(elem, pattern, to_key))
+            if (!match_pattern(elem, patterns[i], to_key))
             {
                 return false;
             }
@@ -1091,25 +1524,13 @@ interpreter::visit_binary_expression(ast::binary_expression& binop)
 
 object::object interpreter::visit_upto(ast::Upto& upto)
 {
-    auto start = TRY(upto.start->accept(*this));
-    if (!IS_NUMBER(start))
+    double start, end;
+    if (!evaluate_upto(*this, upto, start, end))
     {
-        interp_error(upto.span_, "upto expected start to be a number");
         return object::invalid;
     }
 
-    auto end = TRY(upto.end->accept(*this));
-    if (!IS_NUMBER(start))
-    {
-        interp_error(upto.span_, "upto expected end to be a number");
-        return object::invalid;
-    }
-
-    return object::create_number_sequence(
-        *this,
-        upto.span_,
-        AS_NUMBER(end),
-        AS_NUMBER(start));
+    return object::create_number_sequence(*this, upto.span_, end, start);
 }
 
 object::object interpreter::visit_lnot_expression(ast::lnot_expression& e)
@@ -1149,6 +1570,30 @@ interpreter::visit_perform_expression(ast::perform_expression& expr)
     return gaya::eval::object::create_unit(expr.op.span);
 }
 
+object::object
+interpreter::visit_generator_expression(ast::generator_expression& expr)
+{
+    auto state = std::make_shared<generator>(expr.body, environment());
+    return object::create_sequence(
+        *this,
+        object::sequence {
+            expr.span_,
+            object::sequence_type_generator,
+            object::generator_sequence { state },
+        });
+}
+
+object::object interpreter::visit_yield_expression(ast::yield_expression& expr)
+{
+    auto value = expr.expr->accept(*this);
+    RETURN_IF_INVALID(value);
+
+    assert(_generator && "yield outside of a generator");
+    _generator->yield(*this, value);
+
+    return object::create_unit(expr.span_);
+}
+
 object::object
 interpreter::visit_get_expression(ast::get_expression& get_expression)
 {
@@ -1162,9 +1607,9 @@ interpreter::visit_get_expression(ast::get_expression& get_expression)
         auto& dict = AS_DICT(receiver);
         auto key
             = object::create_string(*this, span, get_expression.ident.value);
-        if (auto it = dict.find(key); it != dict.end())
+        if (auto index = dict.find(key); index)
         {
-            return it->second;
+            return dict.value(*index);
         }
         return object::create_unit(span);
     }
@@ -1324,7 +1769,7 @@ object::object interpreter::visit_array(ast::array& ary)
 
 object::object interpreter::visit_dictionary(ast::dictionary& dict_expr)
 {
-    robin_hood::unordered_map<object::object, object::object> dict;
+    object::dictionary dict { dict_expr.span_ };
 
     for (size_t i = 0; i < dict_expr.keys.size(); i++)
     {
@@ -1334,7 +1779,7 @@ object::object interpreter::visit_dictionary(ast::dictionary& dict_expr)
         auto value = dict_expr.values[i]->accept(*this);
         RETURN_IF_INVALID(value);
 
-        dict.insert({ key, value });
+        dict.try_emplace(*this, key, value);
     }
 
     return object::create_dictionary(*this, dict_expr.span_, std::move(dict));
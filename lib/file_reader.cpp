@@ -1,4 +1,5 @@
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <cstdio>
@@ -9,6 +10,8 @@
 namespace gaya
 {
 
+static constexpr size_t line_reader_buffer_size = 64 * 1024;
+
 file_reader::file_reader(std::filesystem::path p)
     : _path { p }
 {
@@ -18,6 +21,14 @@ file_reader::file_reader(std::filesystem::path p)
     }
 }
 
+file_reader::~file_reader()
+{
+    if (_mapping)
+    {
+        munmap(_mapping, _mapping_size);
+    }
+}
+
 file_reader::operator bool() const noexcept
 {
     return _valid;
@@ -33,9 +44,182 @@ char* file_reader::slurp() noexcept
     auto filesize  = std::filesystem::file_size(_path);
     auto* contents = (char*)calloc(filesize + 1, sizeof(char));
 
-    if (read(fd, contents, filesize) == -1) return {};
+    auto result = read(fd, contents, filesize);
+    close(fd);
+
+    if (result == -1)
+    {
+        free(contents);
+        return {};
+    }
 
     return contents;
 }
 
+std::optional<std::string_view> file_reader::map() noexcept
+{
+    if (!_valid) return {};
+    if (_mapping) return std::string_view { (char*)_mapping, _mapping_size };
+
+    auto fd = open(_path.string().c_str(), O_RDONLY);
+    if (fd == -1) return {};
+
+    std::error_code ec;
+    auto filesize = std::filesystem::file_size(_path, ec);
+    if (ec)
+    {
+        close(fd);
+        return {};
+    }
+
+    /* Zero-length mappings are not allowed. */
+    if (filesize == 0)
+    {
+        close(fd);
+        return std::string_view {};
+    }
+
+    auto* mapping = mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) return {};
+
+    madvise(mapping, filesize, MADV_SEQUENTIAL);
+
+    _mapping      = mapping;
+    _mapping_size = filesize;
+
+    return std::string_view { (char*)_mapping, _mapping_size };
+}
+
+line_reader::line_reader(std::filesystem::path p, size_t offset)
+    : _path { p }
+    , _buffer(line_reader_buffer_size)
+    , _buffer_offset { offset }
+{
+    _fd = open(_path.string().c_str(), O_RDONLY);
+    if (_fd == -1) return;
+
+    if (offset > 0 && lseek(_fd, offset, SEEK_SET) == -1)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+line_reader::line_reader(int fd)
+    : _fd { fd }
+    , _owns_fd { false }
+    , _buffer(line_reader_buffer_size)
+{
+}
+
+line_reader::~line_reader()
+{
+    if (_fd != -1 && _owns_fd)
+    {
+        close(_fd);
+    }
+}
+
+line_reader::operator bool() const noexcept
+{
+    return _fd != -1 || _start < _end;
+}
+
+const std::filesystem::path& line_reader::path() const noexcept
+{
+    return _path;
+}
+
+bool line_reader::reopenable() const noexcept
+{
+    return !_path.empty();
+}
+
+size_t line_reader::offset() const noexcept
+{
+    return _buffer_offset + _start;
+}
+
+bool line_reader::fill() noexcept
+{
+    if (_fd == -1) return false;
+
+    /* Move the partial line to the front, growing the buffer if it is full. */
+    if (_start > 0)
+    {
+        std::memmove(_buffer.data(), _buffer.data() + _start, _end - _start);
+        _buffer_offset += _start;
+        _end -= _start;
+        _start = 0;
+    }
+    else if (_end == _buffer.size())
+    {
+        _buffer.resize(_buffer.size() * 2);
+    }
+
+    auto n = read(_fd, _buffer.data() + _end, _buffer.size() - _end);
+    if (n <= 0)
+    {
+        /* Release the descriptor as soon as possible, as sequences that are
+         * never collected would otherwise keep it open. */
+        if (_owns_fd) close(_fd);
+        _fd = -1;
+        return false;
+    }
+
+    _end += n;
+    return true;
+}
+
+std::optional<std::string_view> line_reader::next() noexcept
+{
+    size_t searched = _start;
+
+    for (;;)
+    {
+        const auto* begin = _buffer.data() + searched;
+        if (const auto* newline = std::memchr(begin, '\n', _end - searched);
+            newline)
+        {
+            auto end = static_cast<const char*>(newline) - _buffer.data();
+            auto line
+                = std::string_view { _buffer.data() + _start, end - _start };
+            _start = end + 1;
+            return line;
+        }
+
+        searched = _end - _start;
+        if (!fill())
+        {
+            if (_start == _end) return {};
+
+            auto line
+                = std::string_view { _buffer.data() + _start, _end - _start };
+            _start = _end;
+            return line;
+        }
+        searched += _start;
+    }
+}
+
+std::optional<std::string_view> line_reader::next_chunk() noexcept
+{
+    if (_start == _end && !fill())
+    {
+        return {};
+    }
+
+    auto chunk = std::string_view { _buffer.data() + _start, _end - _start };
+    _start     = _end;
+    return chunk;
+}
+
+std::shared_ptr<line_reader> stdin_reader() noexcept
+{
+    static auto reader = std::make_shared<line_reader>(STDIN_FILENO);
+    return reader;
+}
+
 }
@@ -0,0 +1,327 @@
+#include <cassert>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <ast.hpp>
+#include <generator.hpp>
+
+namespace gaya::eval
+{
+
+#if defined(__x86_64__)
+
+/*
+ * Saves the callee-saved registers on the current stack, stores the stack
+ * pointer in *from and pops the registers of the context at to. Unlike
+ * swapcontext, it neither saves the signal mask nor enters the kernel.
+ */
+extern "C" void gaya_switch_context(void** from, void* to) noexcept;
+
+asm(R"(
+    .text
+    .globl gaya_switch_context
+    .hidden gaya_switch_context
+    .type gaya_switch_context, @function
+gaya_switch_context:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size gaya_switch_context, .-gaya_switch_context
+)");
+
+static void switch_context(machine_context& from, machine_context& to) noexcept
+{
+    gaya_switch_context(&from.sp, to.sp);
+}
+
+static void prepare_context(
+    machine_context& context,
+    char* stack,
+    size_t size,
+    void (*entry)()) noexcept
+{
+    /* Lay out the frame of a switch that returns into entry as if it had been
+     * called, with the stack aligned the way the ABI expects. */
+    auto** sp = reinterpret_cast<void**>(stack + size);
+    *--sp     = nullptr;
+    *--sp     = reinterpret_cast<void*>(entry);
+    for (int i = 0; i < 6; i++) *--sp = nullptr;
+
+    context.sp = sp;
+}
+
+static char* stack_low(const machine_context& context) noexcept
+{
+    return static_cast<char*>(context.sp);
+}
+
+#else
+
+[[gnu::noinline]] static void
+switch_context(machine_context& from, machine_context& to) noexcept
+{
+    /* The saved stack pointer is that of this frame, which is smaller than
+     * the margin. */
+    char marker;
+    from.low = &marker - 1024;
+    swapcontext(&from.registers, &to.registers);
+}
+
+static void prepare_context(
+    machine_context& context,
+    char* stack,
+    size_t size,
+    void (*entry)()) noexcept
+{
+    getcontext(&context.registers);
+    context.registers.uc_stack.ss_sp   = stack;
+    context.registers.uc_stack.ss_size = size;
+    context.registers.uc_link          = nullptr;
+    makecontext(&context.registers, entry, 0);
+}
+
+static char* stack_low(const machine_context& context) noexcept
+{
+    return context.low;
+}
+
+#endif
+
+/*
+ * The stack is only reserved, so its size costs address space and not memory.
+ * It matches the usual size of the main stack, so that a body can recurse as
+ * deeply as the code around it.
+ */
+static constexpr size_t stack_size = 8 * 1024 * 1024;
+
+static char* shared_stack = nullptr;
+
+/* The generator whose frames are on the shared stack, and the context whose
+ * stack pointer tells where they end. */
+static generator* occupant               = nullptr;
+static machine_context* occupant_context = nullptr;
+
+/*
+ * Frames cannot be moved on or off the shared stack by code running on it, so
+ * switches between two generators go through a loop on a small stack of its
+ * own that does it.
+ */
+static constexpr size_t switcher_stack_size = 64 * 1024;
+alignas(16) static char switcher_stack[switcher_stack_size];
+static machine_context switcher;
+static machine_context* switch_target = nullptr;
+static generator* switch_owner        = nullptr;
+
+/* The generator whose body is entered by the next switch to a new context. */
+static generator* entering = nullptr;
+
+bool generator::reserve_stack() noexcept
+{
+    if (shared_stack) return true;
+
+    auto* stack = mmap(
+        nullptr,
+        stack_size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK,
+        -1,
+        0);
+    if (stack == MAP_FAILED) return false;
+
+    /* The lowest page is a guard, so an overflow faults instead of writing
+     * over whatever comes before the stack. */
+    mprotect(stack, static_cast<size_t>(sysconf(_SC_PAGESIZE)), PROT_NONE);
+
+    shared_stack = static_cast<char*>(stack);
+    prepare_context(
+        switcher,
+        switcher_stack,
+        switcher_stack_size,
+        &generator::switch_stacks);
+    return true;
+}
+
+generator::generator(std::shared_ptr<ast::expression> body, env base) noexcept
+    : _body { std::move(body) }
+{
+    /* The body is a do block, so its own scope goes right on top of the one
+     * the generator was made in. */
+    _context.scopes.push_back(std::move(base));
+}
+
+generator::~generator()
+{
+    if (occupant == this) occupant = nullptr;
+}
+
+bool generator::started() const noexcept
+{
+    return _state != state::created;
+}
+
+const std::shared_ptr<ast::expression>& generator::body() const noexcept
+{
+    return _body;
+}
+
+const std::vector<env>& generator::scopes() const noexcept
+{
+    return _context.scopes;
+}
+
+object::object generator::resume(interpreter& interp, span span) noexcept
+{
+    switch (_state)
+    {
+    case state::created:
+    {
+        if (!reserve_stack())
+        {
+            interp.interp_error(span, "Could not allocate a generator stack");
+            return object::invalid;
+        }
+        break;
+    }
+    case state::suspended:
+    {
+        break;
+    }
+    case state::running:
+    {
+        interp.interp_error(span, "Generator is already running");
+        interp.interp_hint(span, "A generator cannot read itself");
+        return object::invalid;
+    }
+    case state::done:
+    {
+        return object::create_unit(span);
+    }
+    }
+
+    _interp = &interp;
+    _span   = span;
+    _state  = state::running;
+    _mark   = interp.resume_execution(*this, _context);
+
+    transfer(_caller, _mark.running, _own, this);
+
+    return _value;
+}
+
+void generator::yield(interpreter& interp, object::object value) noexcept
+{
+    assert(_state == state::running);
+
+    _value = value;
+    _state = state::suspended;
+    interp.suspend_execution(_mark, _context);
+
+    transfer(_own, this, _caller, _mark.running);
+}
+
+/*
+ * Switch to another context, where an owner is the generator whose frames a
+ * context runs on, or nullptr for the stack of the thread.
+ */
+void generator::transfer(
+    machine_context& from,
+    generator* from_owner,
+    machine_context& to,
+    generator* to_owner) noexcept
+{
+    if (from_owner) occupant_context = &from;
+
+    if (to_owner && to_owner != occupant)
+    {
+        if (from_owner)
+        {
+            switch_target = &to;
+            switch_owner  = to_owner;
+            switch_context(from, switcher);
+            return;
+        }
+
+        save_occupant();
+        to_owner->restore();
+    }
+
+    switch_context(from, to);
+}
+
+void generator::save_occupant() noexcept
+{
+    if (!occupant) return;
+
+    auto* low = stack_low(*occupant_context);
+    occupant->_frames.assign(low, shared_stack + stack_size);
+    occupant->_frames_at = low;
+    occupant             = nullptr;
+}
+
+void generator::restore() noexcept
+{
+    if (_frames_at)
+    {
+        std::memcpy(_frames_at, _frames.data(), _frames.size());
+    }
+    else
+    {
+        prepare_context(_own, shared_stack, stack_size, &generator::enter);
+        entering = this;
+    }
+
+    occupant = this;
+}
+
+void generator::switch_stacks() noexcept
+{
+    for (;;)
+    {
+        save_occupant();
+        switch_owner->restore();
+        switch_context(switcher, *switch_target);
+    }
+}
+
+void generator::enter() noexcept
+{
+    entering->run();
+    assert(0 && "finished generator was resumed");
+}
+
+void generator::run() noexcept
+{
+    auto& interp = *_interp;
+
+    _body->accept(interp);
+
+    /* Scopes that an error left behind go away along with the rest. */
+    interp.suspend_execution(_mark, _context);
+    _context = {};
+
+    _value = interp.had_error() ? object::invalid : object::create_unit(_span);
+    _state = state::done;
+
+    /* Nothing is left on the shared stack that would need saving. */
+    _frames    = {};
+    _frames_at = nullptr;
+    occupant   = nullptr;
+
+    transfer(_own, this, _caller, _mark.running);
+}
+
+}
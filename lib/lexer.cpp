@@ -27,6 +27,8 @@ std::unordered_map<std::string, token_type> lexer::_keywords = {
     { "struct", token_type::struct_ },
     { "enum", token_type::enum_ },
     { "upto", token_type::upto },
+    { "gen", token_type::gen },
+    { "yield", token_type::yield_ },
 };
 
 lexer::lexer(const char* source)
@@ -6,6 +6,7 @@
 
 #include <env.hpp>
 #include <eval.hpp>
+#include <generator.hpp>
 #include <object.hpp>
 
 namespace gaya::eval::object
@@ -26,30 +27,146 @@ static int next_gc_threshold = 1024 * 1024;
 static robin_hood::unordered_map<size_t, object> strings;
 
 static void mark(heap_object* o);
+static void mark_bindings(const env& env);
 
-static void mark_array(std::vector<object>& elems)
+static void mark_array(const packed_array& elems)
 {
-    for (auto& elem : elems)
+    /* Numbers and units are all there is to arrays of them. */
+    auto kind = elems.kind();
+    if (kind == object_type_number || kind == object_type_unit) return;
+
+    for (size_t i = 0; i < elems.size(); i++)
     {
-        if (IS_HEAP_OBJECT(elem))
+        if (nanbox_is_pointer(elems.box(i)))
         {
-            mark(AS_HEAP_OBJECT(elem));
+            mark(AS_HEAP_OBJECT(elems[i]));
         }
     }
 }
 
-static void mark_dictionary(robin_hood::unordered_map<object, object>& dict)
+static void mark_object(const object& o)
+{
+    if (IS_HEAP_OBJECT(o))
+    {
+        mark(AS_HEAP_OBJECT(o));
+    }
+}
+
+/*
+ * Mark the objects an adaptor sequence refers to.
+ */
+static void mark_adaptor(const map_sequence& seq)
+{
+    mark_object(seq.inner);
+    mark_object(seq.func);
+}
+
+static void mark_adaptor(const filter_sequence& seq)
+{
+    mark_object(seq.inner);
+    mark_object(seq.pred);
+}
+
+static void mark_adaptor(const takewhile_sequence& seq)
+{
+    mark_object(seq.inner);
+    mark_object(seq.pred);
+}
+
+static void mark_adaptor(const dropwhile_sequence& seq)
+{
+    mark_object(seq.inner);
+    mark_object(seq.pred);
+}
+
+static void mark_adaptor(const flatten_sequence& seq)
+{
+    mark_object(seq.inner);
+    mark_object(seq.current);
+}
+
+static void mark_adaptor(const unique_sequence& seq)
+{
+    mark_object(seq.inner);
+    for (const auto& x : seq.seen)
+    {
+        mark_object(x);
+    }
+}
+
+template <typename Adaptor>
+static void mark_adaptor(const Adaptor& seq)
+{
+    mark_object(seq.inner);
+}
+
+static void mark_dictionary(const dictionary& dict)
 {
-    for (auto it : dict)
+    for (const auto& [key, value] : dict)
     {
-        if (IS_HEAP_OBJECT(it.first))
+        if (IS_HEAP_OBJECT(key))
         {
-            mark(AS_HEAP_OBJECT(it.first));
+            mark(AS_HEAP_OBJECT(key));
         }
 
-        if (IS_HEAP_OBJECT(it.second))
+        if (IS_HEAP_OBJECT(value))
         {
-            mark(AS_HEAP_OBJECT(it.second));
+            mark(AS_HEAP_OBJECT(value));
+        }
+    }
+}
+
+static void mark_set(const hash_set& set)
+{
+    for (const auto& x : set)
+    {
+        if (IS_HEAP_OBJECT(x))
+        {
+            mark(AS_HEAP_OBJECT(x));
+        }
+    }
+}
+
+static void mark_priority_queue(const priority_queue& queue)
+{
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        if (IS_HEAP_OBJECT(queue[i]))
+        {
+            mark(AS_HEAP_OBJECT(queue[i]));
+        }
+    }
+}
+
+static void mark_deque(const ring_buffer& deque)
+{
+    for (size_t i = 0; i < deque.size(); i++)
+    {
+        if (IS_HEAP_OBJECT(deque[i]))
+        {
+            mark(AS_HEAP_OBJECT(deque[i]));
+        }
+    }
+}
+
+static void mark_grid(const dense_grid& grid)
+{
+    for (size_t i = 0; i < grid.size(); i++)
+    {
+        if (IS_HEAP_OBJECT(grid[i]))
+        {
+            mark(AS_HEAP_OBJECT(grid[i]));
+        }
+    }
+}
+
+static void mark_tuple(const tuple& t)
+{
+    for (size_t i = 0; i < t.size(); i++)
+    {
+        if (IS_HEAP_OBJECT(t[i]))
+        {
+            mark(AS_HEAP_OBJECT(t[i]));
         }
     }
 }
@@ -72,6 +189,35 @@ static void mark(heap_object* o)
         mark_dictionary(o->as_dictionary);
         break;
     }
+    case object_type_tuple:
+    {
+        mark_tuple(o->as_tuple);
+        break;
+    }
+    case object_type_set:
+    {
+        mark_set(o->as_set);
+        break;
+    }
+    case object_type_priority_queue:
+    {
+        mark_priority_queue(o->as_priority_queue);
+        break;
+    }
+    case object_type_deque:
+    {
+        mark_deque(o->as_deque);
+        break;
+    }
+    case object_type_grid:
+    {
+        mark_grid(o->as_grid);
+        break;
+    }
+    case object_type_typed_array:
+    {
+        break;
+    }
     case object_type_sequence:
     {
         if (auto* user_seq
@@ -87,14 +233,79 @@ static void mark(heap_object* o)
                  = std::get_if<array_sequence>(&o->as_sequence.seq);
                  array_seq)
         {
-            mark_array(const_cast<std::vector<object>&>(array_seq->elems));
+            mark(AS_HEAP_OBJECT(array_seq->array));
         }
         else if (auto* dict_seq
                  = std::get_if<dict_sequence>(&o->as_sequence.seq);
                  dict_seq)
         {
-            mark_array(dict_seq->keys);
-            mark_array(dict_seq->values);
+            mark(AS_HEAP_OBJECT(dict_seq->dict));
+        }
+        else if (auto* tuple_seq
+                 = std::get_if<tuple_sequence>(&o->as_sequence.seq);
+                 tuple_seq)
+        {
+            mark(AS_HEAP_OBJECT(tuple_seq->tuple));
+        }
+        else if (auto* set_seq
+                 = std::get_if<set_sequence>(&o->as_sequence.seq);
+                 set_seq)
+        {
+            mark(AS_HEAP_OBJECT(set_seq->set));
+        }
+        else if (auto* deque_seq
+                 = std::get_if<deque_sequence>(&o->as_sequence.seq);
+                 deque_seq)
+        {
+            mark(AS_HEAP_OBJECT(deque_seq->deque));
+        }
+        else if (auto* typed_array_seq
+                 = std::get_if<typed_array_sequence>(&o->as_sequence.seq);
+                 typed_array_seq)
+        {
+            mark(AS_HEAP_OBJECT(typed_array_seq->array));
+        }
+        else if (auto* split_seq
+                 = std::get_if<split_sequence>(&o->as_sequence.seq);
+                 split_seq)
+        {
+            mark(AS_HEAP_OBJECT(split_seq->string));
+        }
+        else if (auto* segments_seq
+                 = std::get_if<segments_sequence>(&o->as_sequence.seq);
+                 segments_seq)
+        {
+            mark(AS_HEAP_OBJECT(segments_seq->elems));
+        }
+        else if (auto* tee_seq
+                 = std::get_if<tee_sequence>(&o->as_sequence.seq);
+                 tee_seq)
+        {
+            mark_object(tee_seq->buffer->source());
+            for (const auto& x : tee_seq->buffer->buffered())
+            {
+                mark_object(x);
+            }
+        }
+        else if (auto* generator_seq
+                 = std::get_if<generator_sequence>(&o->as_sequence.seq);
+                 generator_seq)
+        {
+            for (const auto& scope : generator_seq->state->scopes())
+            {
+                mark_bindings(scope);
+            }
+        }
+        else
+        {
+            std::visit(
+                [](const auto& seq) {
+                    if constexpr (requires { seq.inner; })
+                    {
+                        mark_adaptor(seq);
+                    }
+                },
+                o->as_sequence.seq);
         }
         break;
     }
@@ -259,9 +470,17 @@ object create_array(
     interpreter& interp,
     span span,
     const std::vector<object>& elems) noexcept
+{
+    return create_array(interp, span, packed_array { span, elems });
+}
+
+object create_array(interpreter& interp, span span, packed_array elems) noexcept
 {
     auto* ptr = create_heap_object(interp);
-    new (ptr) heap_object { .type = object_type_array, .as_array = elems };
+    new (ptr) heap_object {
+        .type     = object_type_array,
+        .as_array = std::move(elems),
+    };
 
     auto o = create_object(object_type_array, span);
     o.box  = nanbox_from_pointer(ptr);
@@ -269,15 +488,121 @@ object create_array(
     return o;
 }
 
-object create_dictionary(
+object create_tuple(
+    interpreter& interp,
+    span span,
+    const std::vector<object>& elems) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type     = object_type_tuple,
+        .as_tuple = tuple { span, elems },
+    };
+
+    auto o = create_object(object_type_tuple, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object create_tuple(
+    interpreter& interp,
+    span span,
+    const packed_array& elems) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type     = object_type_tuple,
+        .as_tuple = tuple { span, elems },
+    };
+
+    auto o = create_object(object_type_tuple, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object create_deque(interpreter& interp, span span, ring_buffer deque) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type     = object_type_deque,
+        .as_deque = std::move(deque),
+    };
+
+    auto o = create_object(object_type_deque, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object create_grid(interpreter& interp, span span, dense_grid grid) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type    = object_type_grid,
+        .as_grid = std::move(grid),
+    };
+
+    auto o = create_object(object_type_grid, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object
+create_typed_array(interpreter& interp, span span, typed_array array) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type           = object_type_typed_array,
+        .as_typed_array = std::move(array),
+    };
+
+    auto o = create_object(object_type_typed_array, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object create_priority_queue(
     interpreter& interp,
     span span,
-    const robin_hood::unordered_map<object, object>& dict) noexcept
+    priority_queue queue) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type              = object_type_priority_queue,
+        .as_priority_queue = std::move(queue),
+    };
+
+    auto o = create_object(object_type_priority_queue, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object create_set(interpreter& interp, span span, hash_set set) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object {
+        .type   = object_type_set,
+        .as_set = std::move(set),
+    };
+
+    auto o = create_object(object_type_set, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object
+create_dictionary(interpreter& interp, span span, dictionary dict) noexcept
 {
     auto* ptr = create_heap_object(interp);
     new (ptr) heap_object {
         .type          = object_type_dictionary,
-        .as_dictionary = dict,
+        .as_dictionary = std::move(dict),
     };
 
     auto o = create_object(object_type_dictionary, span);
@@ -370,11 +695,11 @@ object create_function(
 object create_array_sequence(
     interpreter& interp,
     span span,
-    const std::vector<object>& elems) noexcept
+    const object& array) noexcept
 {
     auto* ptr = create_heap_object(interp);
 
-    array_sequence array_seq = { elems };
+    array_sequence array_seq = { array };
     sequence seq             = { span, sequence_type_array, array_seq };
     new (ptr) heap_object { .type = object_type_sequence, .as_sequence = seq };
 
@@ -437,24 +762,79 @@ create_user_sequence(span span, interpreter& interp, object next_func) noexcept
 [[nodiscard]] object create_dict_sequence(
     interpreter& interp,
     span span,
-    const robin_hood::unordered_map<object, object>& dict) noexcept
+    object dict,
+    dict_sequence_kind kind) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+
+    const auto& entries    = AS_DICT(dict);
+    dict_sequence dict_seq = {
+        dict,
+        entries.next_index(0),
+        entries.changes(),
+        kind,
+    };
+    sequence seq           = { span, sequence_type_dict, dict_seq };
+    new (ptr) heap_object { .type = object_type_sequence, .as_sequence = seq };
+
+    auto o = create_object(object_type_sequence, span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+object create_set_sequence(interpreter& interp, span span, object set) noexcept
+{
+    const auto& elems    = AS_SET(set);
+    set_sequence set_seq = { set, elems.next_index(0), elems.changes() };
+    return create_sequence(
+        interp,
+        sequence { span, sequence_type_set, set_seq });
+}
+
+object create_split_sequence(
+    interpreter& interp,
+    span span,
+    object string,
+    const std::string& separator) noexcept
 {
     auto* ptr = create_heap_object(interp);
 
-    std::vector<object> keys(dict.size(), invalid);
-    std::vector<object> values(dict.size(), invalid);
+    split_sequence split_seq = { string, separator };
+    sequence seq             = { span, sequence_type_split, split_seq };
+    new (ptr) heap_object { .type = object_type_sequence, .as_sequence = seq };
 
-    size_t i = 0;
+    auto o = create_object(object_type_sequence, span);
+    o.box  = nanbox_from_pointer(ptr);
 
-    for (const auto& [k, v] : dict)
+    return o;
+}
+
+object create_lines_sequence(
+    interpreter& interp,
+    span span,
+    const std::filesystem::path& path,
+    size_t offset) noexcept
+{
+    auto reader = std::make_shared<line_reader>(path, offset);
+    if (!*reader)
     {
-        keys[i]   = k;
-        values[i] = v;
-        i         = i + 1;
+        return create_unit(span);
     }
 
-    dict_sequence dict_seq = { keys, values };
-    sequence seq           = { span, sequence_type_dict, dict_seq };
+    return create_lines_sequence(interp, span, std::move(reader));
+}
+
+object create_lines_sequence(
+    interpreter& interp,
+    span span,
+    std::shared_ptr<line_reader> reader,
+    bool chunks) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+
+    lines_sequence lines_seq = { std::move(reader), chunks };
+    sequence seq             = { span, sequence_type_lines, lines_seq };
     new (ptr) heap_object { .type = object_type_sequence, .as_sequence = seq };
 
     auto o = create_object(object_type_sequence, span);
@@ -463,45 +843,166 @@ create_user_sequence(span span, interpreter& interp, object next_func) noexcept
     return o;
 }
 
+object create_sequence(interpreter& interp, sequence seq) noexcept
+{
+    auto* ptr = create_heap_object(interp);
+    new (ptr) heap_object { .type = object_type_sequence, .as_sequence = seq };
+
+    auto o = create_object(object_type_sequence, seq.seq_span);
+    o.box  = nanbox_from_pointer(ptr);
+
+    return o;
+}
+
+/*
+ * Copy the sequence an adaptor is reading from.
+ */
+static object
+copy_inner(interpreter& interp, span span, const object& inner) noexcept
+{
+    if (!IS_SEQUENCE(inner))
+    {
+        return inner;
+    }
+
+    return copy_sequence(interp, span, AS_SEQUENCE(inner));
+}
+
+/*
+ * Copy an adaptor sequence, copying the sequence it reads from as well.
+ */
+template <typename Adaptor>
+static object copy_adaptor(
+    interpreter& interp,
+    span span,
+    const sequence& xs) noexcept
+{
+    auto adaptor  = std::get<Adaptor>(xs.seq);
+    adaptor.inner = copy_inner(interp, span, adaptor.inner);
+    return create_sequence(interp, sequence { span, xs.type, adaptor });
+}
+
 [[nodiscard]] object
 copy_sequence(interpreter& interp, span span, const sequence& xs) noexcept
 {
     switch (xs.type)
     {
+    /* These only hold a position in what they iterate, so the copy starts
+     * where the original is. */
     case sequence_type_string:
-        return create_string_sequence(
-            interp,
-            span,
-            std::get<string_sequence>(xs.seq).string);
     case sequence_type_number:
-        return create_number_sequence(
-            interp,
-            span,
-            std::get<number_sequence>(xs.seq).upto);
     case sequence_type_array:
-        return create_array_sequence(
+    case sequence_type_dict:
+    case sequence_type_segments:
+    case sequence_type_tuple:
+    case sequence_type_set:
+    case sequence_type_deque:
+    case sequence_type_typed_array:
+        return create_sequence(interp, sequence { span, xs.type, xs.seq });
+    case sequence_type_split:
+    {
+        const auto& split_seq = std::get<split_sequence>(xs.seq);
+        auto o                = create_split_sequence(
             interp,
             span,
-            std::get<array_sequence>(xs.seq).elems);
-    case sequence_type_dict:
+            split_seq.string,
+            split_seq.separator);
+        auto& copy = std::get<split_sequence>(AS_SEQUENCE(o).seq);
+        copy.index = split_seq.index;
+        copy.done  = split_seq.done;
+        return o;
+    }
+    case sequence_type_lines:
     {
-        const auto& dict_seq = std::get<dict_sequence>(xs.seq);
-        const auto& keys     = dict_seq.keys;
-        const auto& values   = dict_seq.values;
-        robin_hood::unordered_map<object, object> dict;
+        const auto& lines_seq = std::get<lines_sequence>(xs.seq);
+        const auto& reader    = lines_seq.reader;
+
+        /*
+         * NOTE: Standard input cannot be rewound, so copies of a sequence over
+         *       it share the reader and consume the same stream.
+         */
+        if (!reader->reopenable())
+        {
+            return create_lines_sequence(
+                interp,
+                span,
+                reader,
+                lines_seq.chunks);
+        }
 
-        for (size_t i = 0; i < keys.size(); i++)
+        return create_lines_sequence(
+            interp,
+            span,
+            reader->path(),
+            reader->offset());
+    }
+    case sequence_type_map:
+        return copy_adaptor<map_sequence>(interp, span, xs);
+    case sequence_type_filter:
+        return copy_adaptor<filter_sequence>(interp, span, xs);
+    case sequence_type_take:
+        return copy_adaptor<take_sequence>(interp, span, xs);
+    case sequence_type_drop:
+        return copy_adaptor<drop_sequence>(interp, span, xs);
+    case sequence_type_takewhile:
+        return copy_adaptor<takewhile_sequence>(interp, span, xs);
+    case sequence_type_dropwhile:
+        return copy_adaptor<dropwhile_sequence>(interp, span, xs);
+    case sequence_type_enumerate:
+        return copy_adaptor<enumerate_sequence>(interp, span, xs);
+    case sequence_type_unique:
+        return copy_adaptor<unique_sequence>(interp, span, xs);
+    case sequence_type_flatten:
+    {
+        auto flatten_seq    = std::get<flatten_sequence>(xs.seq);
+        flatten_seq.inner   = copy_inner(interp, span, flatten_seq.inner);
+        flatten_seq.current = copy_inner(interp, span, flatten_seq.current);
+        return create_sequence(
+            interp,
+            sequence { span, sequence_type_flatten, flatten_seq });
+    }
+    case sequence_type_tee:
+    {
+        /* A copy of a cursor is just another cursor over the same buffer. */
+        auto tee_seq   = std::get<tee_sequence>(xs.seq);
+        auto position  = tee_seq.buffer->position(tee_seq.cursor);
+        tee_seq.cursor = tee_seq.buffer->add_cursor(position);
+        return create_sequence(
+            interp,
+            sequence { span, sequence_type_tee, tee_seq });
+    }
+    case sequence_type_generator:
+    {
+        /*
+         * NOTE: A body that has started has native frames on its own stack,
+         *       which cannot be copied, so only fresh generators are.
+         */
+        const auto& state = std::get<generator_sequence>(xs.seq).state;
+        if (state->started())
         {
-            dict.insert({ keys[i], values[i] });
+            interp.interp_error(span, "Cannot copy a generator once started");
+            interp.interp_hint(
+                span,
+                "Use seq.tee to read the rest of it more than once");
+            return invalid;
         }
 
-        return create_dict_sequence(interp, span, dict);
+        auto copy = std::make_shared<generator>(
+            state->body(),
+            state->scopes().front().fork(interp, span));
+        return create_sequence(
+            interp,
+            sequence {
+                span,
+                sequence_type_generator,
+                generator_sequence { copy },
+            });
     }
     case sequence_type_user:
     {
         auto user_seq = std::get<user_defined_sequence>(xs.seq);
         auto& func    = AS_FUNCTION(user_seq.next_func);
-        auto new_env  = func.closed_over_env->deep_copy(interp, span);
+        auto new_env  = func.closed_over_env->fork(interp, span);
         auto new_func = create_function(
             interp,
             span,
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <cassert>
 
 #include <nanbox.h>
+
+#include <ast.hpp>
 #include <object.hpp>
 
 namespace gaya::eval::object
@@ -13,6 +16,9 @@ size_t arity(const object& o) noexcept
     case object_type_string:
     case object_type_array:
     case object_type_dictionary:
+    case object_type_tuple:
+    case object_type_deque:
+    case object_type_typed_array:
     {
         return 1;
     }
@@ -28,9 +34,15 @@ size_t arity(const object& o) noexcept
     {
         return AS_STRUCT(o).fields.size();
     }
+    case object_type_grid:
+    {
+        return 2;
+    }
     case object_type_number:
     case object_type_unit:
     case object_type_sequence:
+    case object_type_set:
+    case object_type_priority_queue:
     case object_type_invalid:
     case object_type_enum:
     {
@@ -41,4 +53,19 @@ size_t arity(const object& o) noexcept
     assert(0 && "unhandled case in arity");
 }
 
+bool accepts(const object& o, size_t nargs) noexcept
+{
+    if (!is_callable(o)) return false;
+
+    auto n = arity(o);
+    if (nargs == n) return true;
+    if (nargs > n || !IS_FUNCTION(o)) return false;
+
+    const auto& params = AS_FUNCTION(o).params;
+    return std::all_of(
+        params.begin() + nargs,
+        params.end(),
+        [](const auto& param) { return param.default_value != nullptr; });
+}
+
 }
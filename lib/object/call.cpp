@@ -14,8 +14,24 @@ namespace gaya::eval::object
 object call_function(
     function& func,
     interpreter& interp,
-    const std::vector<object>& args) noexcept
+    const std::vector<object>& given) noexcept
 {
+    /* Native callers may leave out parameters with default values, which are
+     * evaluated where the call happens, as in a call expression. */
+    std::vector<object> defaulted;
+    if (given.size() < func.params.size())
+    {
+        defaulted = given;
+        for (size_t i = given.size(); i < func.params.size(); i++)
+        {
+            assert(func.params[i].default_value);
+            auto arg = func.params[i].default_value->accept(interp);
+            if (!is_valid(arg)) return invalid;
+            defaulted.push_back(arg);
+        }
+    }
+    const auto& args = defaulted.empty() ? given : defaulted;
+
     interp.begin_scope(env { func.closed_over_env });
 
     for (size_t i = 0; i < args.size(); i++)
@@ -59,7 +75,7 @@ object call_function(
 }
 
 object call_array(
-    std::vector<object>& elems,
+    const packed_array& elems,
     interpreter& interp,
     span span,
     const std::vector<object>& args) noexcept
@@ -85,14 +101,122 @@ object call_array(
     return elems[i];
 }
 
+object call_tuple(
+    const tuple& t,
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!IS_NUMBER(args[0]))
+    {
+        interp.interp_error(span, "Can only index tuples with numbers");
+        return invalid;
+    }
+
+    auto i = AS_NUMBER(args[0]);
+    if (i < 0 || i >= t.size())
+    {
+        interp.interp_error(
+            span,
+            fmt::format("Invalid index for tuple of size {}: {}", t.size(), i));
+        return invalid;
+    }
+
+    return t[i];
+}
+
+object call_deque(
+    const ring_buffer& deque,
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!IS_NUMBER(args[0]))
+    {
+        interp.interp_error(span, "Can only index deques with numbers");
+        return invalid;
+    }
+
+    auto i = AS_NUMBER(args[0]);
+    if (i < 0 || i >= deque.size())
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid index for deque of size {}: {}",
+                deque.size(),
+                i));
+        return invalid;
+    }
+
+    return deque[static_cast<size_t>(i)];
+}
+
+object call_typed_array(
+    const typed_array& array,
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!IS_NUMBER(args[0]))
+    {
+        interp.interp_error(span, "Can only index arrays with numbers");
+        return invalid;
+    }
+
+    auto i = AS_NUMBER(args[0]);
+    if (i < 0 || i >= array.size())
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid index for array of size {}: {}",
+                array.size(),
+                i));
+        return invalid;
+    }
+
+    return create_number(span, array.at(static_cast<size_t>(i)));
+}
+
+object call_grid(
+    const dense_grid& grid,
+    interpreter& interp,
+    span span,
+    const std::vector<object>& args) noexcept
+{
+    if (!IS_NUMBER(args[0]) || !IS_NUMBER(args[1]))
+    {
+        interp.interp_error(span, "Can only index grids with numbers");
+        return invalid;
+    }
+
+    auto x = AS_NUMBER(args[0]);
+    auto y = AS_NUMBER(args[1]);
+    if (!grid.contains(x, y))
+    {
+        interp.interp_error(
+            span,
+            fmt::format(
+                "Invalid point for grid of size {}x{}: ({}, {})",
+                grid.width(),
+                grid.height(),
+                x,
+                y));
+        return invalid;
+    }
+
+    return grid.at(static_cast<size_t>(x), static_cast<size_t>(y));
+}
+
 object call_dict(
-    robin_hood::unordered_map<object, object>& dict,
+    const dictionary& dict,
     span span,
     const std::vector<object>& args) noexcept
 {
-    if (auto it = dict.find(args[0]); it != dict.end())
+    if (auto index = dict.find(args[0]); index)
     {
-        return it->second;
+        return dict.value(*index);
     }
 
     return create_unit(span);
@@ -183,6 +307,22 @@ object call(
     {
         return call_dict(AS_DICT(o), span, args);
     }
+    case object_type_tuple:
+    {
+        return call_tuple(AS_TUPLE(o), interp, span, args);
+    }
+    case object_type_deque:
+    {
+        return call_deque(AS_DEQUE(o), interp, span, args);
+    }
+    case object_type_grid:
+    {
+        return call_grid(AS_GRID(o), interp, span, args);
+    }
+    case object_type_typed_array:
+    {
+        return call_typed_array(AS_TYPED_ARRAY(o), interp, span, args);
+    }
     case object_type_function:
     {
         return call_function(AS_FUNCTION(o), interp, args);
@@ -198,6 +338,8 @@ object call(
     case object_type_number:
     case object_type_unit:
     case object_type_sequence:
+    case object_type_set:
+    case object_type_priority_queue:
     case object_type_invalid:
     case object_type_enum:
     {
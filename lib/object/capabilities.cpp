@@ -0,0 +1,393 @@
+#include <algorithm>
+#include <cmath>
+#include <variant>
+
+#include <nanbox.h>
+
+#include <eval.hpp>
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+/*
+ * The number of elements a count kept as a double stands for. Adaptors loop
+ * while it is positive, so fractions round up.
+ */
+static size_t whole(double n) noexcept
+{
+    return n > 0 ? static_cast<size_t>(std::ceil(n)) : 0;
+}
+
+static size_t left(size_t size, size_t index) noexcept
+{
+    return index < size ? size - index : 0;
+}
+
+std::optional<size_t> exact_size(const object& xs) noexcept
+{
+    if (!IS_SEQUENCE(xs)) return 0;
+
+    return exact_size(AS_SEQUENCE(xs));
+}
+
+std::optional<size_t> exact_size(const sequence& seq) noexcept
+{
+    switch (seq.type)
+    {
+    case sequence_type_string:
+    {
+        const auto& string_seq = std::get<string_sequence>(seq.seq);
+        return left(string_seq.string.size(), string_seq.index);
+    }
+    case sequence_type_array:
+    {
+        const auto& array_seq = std::get<array_sequence>(seq.seq);
+        return left(AS_ARRAY(array_seq.array).size(), array_seq.index);
+    }
+    case sequence_type_tuple:
+    {
+        const auto& tuple_seq = std::get<tuple_sequence>(seq.seq);
+        return left(AS_TUPLE(tuple_seq.tuple).size(), tuple_seq.index);
+    }
+    case sequence_type_deque:
+    {
+        const auto& deque_seq = std::get<deque_sequence>(seq.seq);
+        return left(AS_DEQUE(deque_seq.deque).size(), deque_seq.index);
+    }
+    case sequence_type_typed_array:
+    {
+        const auto& array_seq = std::get<typed_array_sequence>(seq.seq);
+        return left(AS_TYPED_ARRAY(array_seq.array).size(), array_seq.index);
+    }
+    case sequence_type_number:
+    {
+        const auto& number_seq = std::get<number_sequence>(seq.seq);
+        return whole(number_seq.upto - number_seq.i);
+    }
+    case sequence_type_segments:
+    {
+        const auto& segments_seq = std::get<segments_sequence>(seq.seq);
+        return left(segments_seq.length + 1, segments_seq.i);
+    }
+    case sequence_type_map:
+    {
+        return exact_size(std::get<map_sequence>(seq.seq).inner);
+    }
+    case sequence_type_enumerate:
+    {
+        return exact_size(std::get<enumerate_sequence>(seq.seq).inner);
+    }
+    case sequence_type_take:
+    {
+        const auto& take_seq = std::get<take_sequence>(seq.seq);
+        auto size            = exact_size(take_seq.inner);
+        if (!size) return std::nullopt;
+
+        return std::min(*size, whole(take_seq.remaining));
+    }
+    case sequence_type_drop:
+    {
+        const auto& drop_seq = std::get<drop_sequence>(seq.seq);
+        auto size            = exact_size(drop_seq.inner);
+        if (!size) return std::nullopt;
+
+        return left(*size, whole(drop_seq.remaining));
+    }
+    case sequence_type_user:
+    case sequence_type_dict:
+    case sequence_type_set:
+    case sequence_type_split:
+    case sequence_type_lines:
+    case sequence_type_filter:
+    case sequence_type_takewhile:
+    case sequence_type_dropwhile:
+    case sequence_type_flatten:
+    case sequence_type_tee:
+    case sequence_type_generator:
+    case sequence_type_unique:
+    {
+        return std::nullopt;
+    }
+    }
+
+    assert(0 && "unhandled case in exact_size");
+}
+
+std::optional<size_t> skip(object& xs, size_t n) noexcept
+{
+    if (!IS_SEQUENCE(xs)) return 0;
+
+    return skip(AS_SEQUENCE(xs), n);
+}
+
+std::optional<size_t> skip(sequence& seq, size_t n) noexcept
+{
+    switch (seq.type)
+    {
+    case sequence_type_string:
+    {
+        auto& string_seq = std::get<string_sequence>(seq.seq);
+        auto skipped
+            = std::min(n, left(string_seq.string.size(), string_seq.index));
+        string_seq.index += skipped;
+        return skipped;
+    }
+    case sequence_type_array:
+    {
+        /* Arrays may grow later, so this skips what a loop would now. */
+        auto& array_seq = std::get<array_sequence>(seq.seq);
+        auto skipped    = std::min(
+            n,
+            left(AS_ARRAY(array_seq.array).size(), array_seq.index));
+        array_seq.index += skipped;
+        return skipped;
+    }
+    case sequence_type_tuple:
+    {
+        auto& tuple_seq = std::get<tuple_sequence>(seq.seq);
+        auto skipped    = std::min(
+            n,
+            left(AS_TUPLE(tuple_seq.tuple).size(), tuple_seq.index));
+        tuple_seq.index += skipped;
+        return skipped;
+    }
+    case sequence_type_deque:
+    {
+        auto& deque_seq = std::get<deque_sequence>(seq.seq);
+        auto skipped    = std::min(
+            n,
+            left(AS_DEQUE(deque_seq.deque).size(), deque_seq.index));
+        deque_seq.index += skipped;
+        return skipped;
+    }
+    case sequence_type_typed_array:
+    {
+        auto& array_seq = std::get<typed_array_sequence>(seq.seq);
+        auto skipped    = std::min(
+            n,
+            left(AS_TYPED_ARRAY(array_seq.array).size(), array_seq.index));
+        array_seq.index += skipped;
+        return skipped;
+    }
+    case sequence_type_number:
+    {
+        auto& number_seq = std::get<number_sequence>(seq.seq);
+        auto skipped     = std::min(n, whole(number_seq.upto - number_seq.i));
+        number_seq.i += static_cast<double>(skipped);
+        return skipped;
+    }
+    case sequence_type_segments:
+    {
+        auto& segments_seq = std::get<segments_sequence>(seq.seq);
+        auto skipped
+            = std::min(n, left(segments_seq.length + 1, segments_seq.i));
+        segments_seq.i += skipped;
+        return skipped;
+    }
+    case sequence_type_enumerate:
+    {
+        auto& enumerate_seq = std::get<enumerate_sequence>(seq.seq);
+        auto skipped        = skip(enumerate_seq.inner, n);
+        if (skipped) enumerate_seq.index += static_cast<double>(*skipped);
+        return skipped;
+    }
+    case sequence_type_take:
+    {
+        auto& take_seq = std::get<take_sequence>(seq.seq);
+        auto skipped
+            = skip(take_seq.inner, std::min(n, whole(take_seq.remaining)));
+        if (skipped) take_seq.remaining -= static_cast<double>(*skipped);
+        return skipped;
+    }
+    case sequence_type_drop:
+    {
+        auto& drop_seq = std::get<drop_sequence>(seq.seq);
+        auto dropped   = whole(drop_seq.remaining);
+        auto skipped   = skip(drop_seq.inner, dropped + n);
+        if (!skipped) return std::nullopt;
+
+        drop_seq.remaining = 0;
+        return left(*skipped, dropped);
+    }
+    case sequence_type_user:
+    case sequence_type_dict:
+    case sequence_type_set:
+    case sequence_type_split:
+    case sequence_type_lines:
+    case sequence_type_map:
+    case sequence_type_filter:
+    case sequence_type_takewhile:
+    case sequence_type_dropwhile:
+    case sequence_type_flatten:
+    case sequence_type_tee:
+    case sequence_type_generator:
+    case sequence_type_unique:
+    {
+        return std::nullopt;
+    }
+    }
+
+    assert(0 && "unhandled case in skip");
+}
+
+static bool indexable(const object& xs) noexcept;
+
+static bool indexable(const sequence& seq) noexcept
+{
+    switch (seq.type)
+    {
+    case sequence_type_string:
+    case sequence_type_array:
+    case sequence_type_tuple:
+    case sequence_type_deque:
+    case sequence_type_typed_array:
+    case sequence_type_number:
+    {
+        return true;
+    }
+    case sequence_type_enumerate:
+    {
+        return indexable(std::get<enumerate_sequence>(seq.seq).inner);
+    }
+    case sequence_type_take:
+    {
+        return indexable(std::get<take_sequence>(seq.seq).inner);
+    }
+    case sequence_type_drop:
+    {
+        return indexable(std::get<drop_sequence>(seq.seq).inner);
+    }
+    default:
+    {
+        return false;
+    }
+    }
+}
+
+static bool indexable(const object& xs) noexcept
+{
+    return !IS_SEQUENCE(xs) || indexable(AS_SEQUENCE(xs));
+}
+
+std::optional<object> element_at(
+    interpreter& interp,
+    span span,
+    const object& xs,
+    size_t n) noexcept
+{
+    if (!IS_SEQUENCE(xs)) return create_unit(span);
+
+    return element_at(interp, AS_SEQUENCE(xs), n);
+}
+
+std::optional<object>
+element_at(interpreter& interp, const sequence& seq, size_t n) noexcept
+{
+    if (!indexable(seq)) return std::nullopt;
+
+    auto span = seq.seq_span;
+
+    switch (seq.type)
+    {
+    case sequence_type_string:
+    {
+        const auto& string_seq = std::get<string_sequence>(seq.seq);
+        if (n >= left(string_seq.string.size(), string_seq.index))
+        {
+            return create_unit(span);
+        }
+
+        auto c = std::string { string_seq.string[string_seq.index + n] };
+        return create_string(interp, span, c);
+    }
+    case sequence_type_array:
+    {
+        const auto& array_seq = std::get<array_sequence>(seq.seq);
+        const auto& array     = AS_ARRAY(array_seq.array);
+        if (n >= left(array.size(), array_seq.index))
+        {
+            return create_unit(span);
+        }
+
+        return array[array_seq.index + n];
+    }
+    case sequence_type_tuple:
+    {
+        const auto& tuple_seq = std::get<tuple_sequence>(seq.seq);
+        const auto& t         = AS_TUPLE(tuple_seq.tuple);
+        if (n >= left(t.size(), tuple_seq.index))
+        {
+            return create_unit(span);
+        }
+
+        return t[tuple_seq.index + n];
+    }
+    case sequence_type_deque:
+    {
+        const auto& deque_seq = std::get<deque_sequence>(seq.seq);
+        const auto& deque     = AS_DEQUE(deque_seq.deque);
+        if (n >= left(deque.size(), deque_seq.index))
+        {
+            return create_unit(span);
+        }
+
+        return deque[deque_seq.index + n];
+    }
+    case sequence_type_typed_array:
+    {
+        const auto& array_seq = std::get<typed_array_sequence>(seq.seq);
+        const auto& array     = AS_TYPED_ARRAY(array_seq.array);
+        if (n >= left(array.size(), array_seq.index))
+        {
+            return create_unit(span);
+        }
+
+        return create_number(span, array.at(array_seq.index + n));
+    }
+    case sequence_type_number:
+    {
+        const auto& number_seq = std::get<number_sequence>(seq.seq);
+        if (n >= whole(number_seq.upto - number_seq.i))
+        {
+            return create_unit(span);
+        }
+
+        return create_number(span, number_seq.i + static_cast<double>(n));
+    }
+    case sequence_type_enumerate:
+    {
+        const auto& enumerate_seq = std::get<enumerate_sequence>(seq.seq);
+        auto x = element_at(interp, span, enumerate_seq.inner, n);
+        if (IS_UNIT(*x)) return x;
+
+        auto index = enumerate_seq.index + static_cast<double>(n);
+        std::vector<object> pair { create_number(span, index), *x };
+        return create_array(interp, span, std::move(pair));
+    }
+    case sequence_type_take:
+    {
+        const auto& take_seq = std::get<take_sequence>(seq.seq);
+        if (n >= whole(take_seq.remaining)) return create_unit(span);
+
+        return element_at(interp, span, take_seq.inner, n);
+    }
+    case sequence_type_drop:
+    {
+        const auto& drop_seq = std::get<drop_sequence>(seq.seq);
+        return element_at(
+            interp,
+            span,
+            drop_seq.inner,
+            whole(drop_seq.remaining) + n);
+    }
+    default:
+    {
+        return std::nullopt;
+    }
+    }
+
+    assert(0 && "unhandled case in element_at");
+}
+
+}
@@ -40,6 +40,12 @@ bool cmp(const object& o1, const object& o2, int* result) noexcept
     }
     case object_type_array:
     case object_type_dictionary:
+    case object_type_tuple:
+    case object_type_set:
+    case object_type_priority_queue:
+    case object_type_deque:
+    case object_type_grid:
+    case object_type_typed_array:
     case object_type_function:
     case object_type_builtin_function:
     case object_type_sequence:
@@ -0,0 +1,48 @@
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+std::pair<size_t, bool> dictionary::try_emplace(
+    interpreter& interp,
+    const object& key,
+    const object& value) noexcept
+{
+    auto [index, inserted] = emplace_key(interp, key);
+    if (inserted) set_value(index, value);
+
+    return { index, inserted };
+}
+
+void dictionary::insert_or_assign(
+    interpreter& interp,
+    const object& key,
+    const object& value) noexcept
+{
+    set_value(emplace_key(interp, key).first, value);
+}
+
+object dictionary::value(size_t index) const noexcept
+{
+    const auto& e = entries()[index];
+    return { e.value_type, _span, e.value };
+}
+
+void dictionary::set_value(size_t index, const object& value) noexcept
+{
+    auto& e      = own_entries()[index];
+    e.value      = value.box;
+    e.value_type = value.type;
+}
+
+dictionary::const_iterator dictionary::begin() const noexcept
+{
+    return { *this, 0 };
+}
+
+dictionary::const_iterator dictionary::end() const noexcept
+{
+    return { *this, end_index() };
+}
+
+}
@@ -21,12 +21,23 @@ bool struct_equals(StructObject& s1, StructObject& s2)
     return true;
 }
 
-bool array_equals(
-    const std::vector<object>& xs,
-    const std::vector<object>& ys) noexcept
+bool array_equals(const packed_array& xs, const packed_array& ys) noexcept
 {
     if (xs.size() != ys.size()) return false;
 
+    if (xs.kind() == object_type_number && ys.kind() == object_type_number)
+    {
+        for (size_t i = 0; i < xs.size(); i++)
+        {
+            if (nanbox_to_double(xs.box(i)) != nanbox_to_double(ys.box(i)))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     for (size_t i = 0; i < xs.size(); i++)
     {
         if (!equals(xs[i], ys[i]))
@@ -38,15 +49,15 @@ bool array_equals(
     return true;
 }
 
-bool dict_equals(
-    const robin_hood::unordered_map<object, object>& d1,
-    const robin_hood::unordered_map<object, object>& d2) noexcept
+bool dict_equals(const dictionary& d1, const dictionary& d2) noexcept
 {
-    for (auto it1 : d1)
+    if (d1.size() != d2.size()) return false;
+
+    for (const auto& [key, value] : d1)
     {
-        if (auto it2 = d2.find(it1.first); it2 != d2.end())
+        if (auto index = d2.find(key); index)
         {
-            if (!equals(it1.second, it2->second))
+            if (!equals(value, d2.value(*index)))
             {
                 return false;
             }
@@ -60,8 +71,112 @@ bool dict_equals(
     return true;
 }
 
+bool set_equals(const hash_set& s1, const hash_set& s2) noexcept
+{
+    if (s1.size() != s2.size()) return false;
+
+    for (const auto& x : s1)
+    {
+        if (!s2.contains(x))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool deque_equals(const ring_buffer& d1, const ring_buffer& d2) noexcept
+{
+    if (d1.size() != d2.size()) return false;
+
+    for (size_t i = 0; i < d1.size(); i++)
+    {
+        if (!equals(d1[i], d2[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Typed arrays are equal if they hold the same numbers, whatever their kinds.
+ */
+bool typed_array_equals(const typed_array& a, const typed_array& b) noexcept
+{
+    if (a.size() != b.size()) return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a.at(i) != b.at(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool grid_equals(const dense_grid& g1, const dense_grid& g2) noexcept
+{
+    if (g1.width() != g2.width() || g1.height() != g2.height()) return false;
+
+    for (size_t i = 0; i < g1.size(); i++)
+    {
+        if (!equals(g1[i], g2[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool tuple_equals(const tuple& t, const packed_array& xs) noexcept
+{
+    if (t.size() != xs.size()) return false;
+
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        if (!equals(t[i], xs[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool tuple_equals(const tuple& t1, const tuple& t2) noexcept
+{
+    /* The hashes are already there, and most unequal tuples differ in them. */
+    if (t1.size() != t2.size() || t1.hash() != t2.hash()) return false;
+
+    for (size_t i = 0; i < t1.size(); i++)
+    {
+        if (!equals(t1[i], t2[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool equals(const object& o1, const object& o2) noexcept
 {
+    /* Tuples are equal to arrays with the same elements. */
+    if (IS_TUPLE(o1) && IS_ARRAY(o2))
+    {
+        return tuple_equals(AS_TUPLE(o1), AS_ARRAY(o2));
+    }
+    if (IS_ARRAY(o1) && IS_TUPLE(o2))
+    {
+        return tuple_equals(AS_TUPLE(o2), AS_ARRAY(o1));
+    }
+
     if (o1.type != o2.type) return false;
 
     switch (o1.type)
@@ -86,6 +201,26 @@ bool equals(const object& o1, const object& o2) noexcept
     {
         return dict_equals(AS_DICT(o1), AS_DICT(o2));
     }
+    case object_type_tuple:
+    {
+        return tuple_equals(AS_TUPLE(o1), AS_TUPLE(o2));
+    }
+    case object_type_set:
+    {
+        return set_equals(AS_SET(o1), AS_SET(o2));
+    }
+    case object_type_deque:
+    {
+        return deque_equals(AS_DEQUE(o1), AS_DEQUE(o2));
+    }
+    case object_type_grid:
+    {
+        return grid_equals(AS_GRID(o1), AS_GRID(o2));
+    }
+    case object_type_typed_array:
+    {
+        return typed_array_equals(AS_TYPED_ARRAY(o1), AS_TYPED_ARRAY(o2));
+    }
     case object_type_struct:
     {
         return struct_equals(AS_STRUCT(o1), AS_STRUCT(o2));
@@ -97,6 +232,7 @@ bool equals(const object& o1, const object& o2) noexcept
     case object_type_function:
     case object_type_builtin_function:
     case object_type_sequence:
+    case object_type_priority_queue:
     case object_type_invalid:
     {
         return false;
@@ -0,0 +1,107 @@
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+dense_grid::dense_grid(
+    span span,
+    size_t width,
+    size_t height,
+    const object& fill) noexcept
+    : _cells(width * height, element { fill.box, fill.type })
+    , _width { width }
+    , _height { height }
+    , _span { span }
+{
+}
+
+std::optional<dense_grid> dense_grid::from_string(
+    interpreter& interp,
+    span span,
+    std::string_view text) noexcept
+{
+    while (!text.empty() && text.back() == '\n') text.remove_suffix(1);
+
+    auto grid = dense_grid { span, 0, 0, create_unit(span) };
+    if (text.empty()) return grid;
+
+    grid._width = text.find('\n');
+    if (grid._width == std::string_view::npos) grid._width = text.size();
+    grid._cells.reserve(text.size());
+
+    /* Grids are made of a handful of distinct characters, so each gets its
+     * string once. */
+    std::array<std::optional<object>, 256> strings;
+
+    size_t column = 0;
+    for (auto c : text)
+    {
+        if (c == '\n')
+        {
+            if (column != grid._width) return std::nullopt;
+
+            grid._height += 1;
+            column = 0;
+            continue;
+        }
+
+        auto& s = strings[static_cast<unsigned char>(c)];
+        if (!s) s = create_string(interp, span, std::string_view { &c, 1 });
+
+        grid._cells.push_back({ s->box, s->type });
+        column += 1;
+    }
+
+    if (column != grid._width) return std::nullopt;
+    grid._height += 1;
+
+    return grid;
+}
+
+size_t dense_grid::width() const noexcept
+{
+    return _width;
+}
+
+size_t dense_grid::height() const noexcept
+{
+    return _height;
+}
+
+size_t dense_grid::size() const noexcept
+{
+    return _cells.size();
+}
+
+bool dense_grid::contains(double x, double y) const noexcept
+{
+    return x >= 0 && y >= 0 && x < static_cast<double>(_width)
+        && y < static_cast<double>(_height) && std::trunc(x) == x
+        && std::trunc(y) == y;
+}
+
+object dense_grid::at(size_t x, size_t y) const noexcept
+{
+    assert(x < _width && y < _height);
+
+    return (*this)[y * _width + x];
+}
+
+void dense_grid::set(size_t x, size_t y, const object& o) noexcept
+{
+    assert(x < _width && y < _height);
+
+    _cells[y * _width + x] = { o.box, o.type };
+}
+
+object dense_grid::operator[](size_t index) const noexcept
+{
+    const auto& e = _cells[index];
+    return { e.type, _span, e.box };
+}
+
+}
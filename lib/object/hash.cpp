@@ -27,29 +27,85 @@ size_t hash(const object& o) noexcept
     }
     case object_type_array:
     {
-        auto ary         = AS_ARRAY(o);
+        const auto& ary  = AS_ARRAY(o);
         std::size_t seed = ary.size();
-        for (auto& elem : ary)
+        if (ary.kind() == object_type_number)
         {
-            seed ^= hash(elem) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            for (size_t i = 0; i < ary.size(); i++)
+            {
+                auto x = nanbox_to_double(ary.box(i));
+                seed   = hash_combine(seed, robin_hood::hash<double> {}(x));
+            }
+            return seed;
+        }
+
+        for (size_t i = 0; i < ary.size(); i++)
+        {
+            seed = hash_combine(seed, hash(ary[i]));
+        }
+        return seed;
+    }
+    case object_type_tuple:
+    {
+        return AS_TUPLE(o).hash();
+    }
+    case object_type_deque:
+    {
+        const auto& deque = AS_DEQUE(o);
+        std::size_t seed  = deque.size();
+        for (size_t i = 0; i < deque.size(); i++)
+        {
+            seed = hash_combine(seed, hash(deque[i]));
+        }
+        return seed;
+    }
+    case object_type_typed_array:
+    {
+        const auto& array = AS_TYPED_ARRAY(o);
+        std::size_t seed  = array.size();
+        for (size_t i = 0; i < array.size(); i++)
+        {
+            seed = hash_combine(seed, hash(array[i]));
+        }
+        return seed;
+    }
+    case object_type_grid:
+    {
+        const auto& grid = AS_GRID(o);
+        std::size_t seed = hash_combine(grid.width(), grid.height());
+        for (size_t i = 0; i < grid.size(); i++)
+        {
+            seed = hash_combine(seed, hash(grid[i]));
+        }
+        return seed;
+    }
+    case object_type_set:
+    {
+        /* Equal sets may have their elements in any order, so the hashes of
+         * the elements are summed. */
+        const auto& set  = AS_SET(o);
+        std::size_t seed = set.size();
+        for (const auto& x : set)
+        {
+            seed += robin_hood::hash_int(hash(x));
         }
         return seed;
     }
     case object_type_dictionary:
     {
-        auto dict        = AS_DICT(o);
+        const auto& dict = AS_DICT(o);
         std::size_t seed = dict.size();
-        for (auto& it : dict)
+        for (const auto& [key, value] : dict)
         {
-            seed ^= hash(it.first) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= hash(it.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= hash(key) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= hash(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
         }
         return seed;
     }
     case object_type_struct:
     {
-        auto struct_object = AS_STRUCT(o);
-        std::size_t seed   = struct_object.fields.size();
+        const auto& struct_object = AS_STRUCT(o);
+        std::size_t seed          = struct_object.fields.size();
         for (auto& field : struct_object.fields)
         {
             seed ^= robin_hood::hash<std::string> {}(field.identifier)
@@ -67,6 +123,7 @@ size_t hash(const object& o) noexcept
     case object_type_function:
     case object_type_builtin_function:
     case object_type_sequence:
+    case object_type_priority_queue:
     {
         return robin_hood::hash<void*> {}(nanbox_to_pointer(o.box));
     }
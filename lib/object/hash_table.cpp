@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+#include <robin_hood.h>
+
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+/* Slot indices that do not refer to an entry. */
+static constexpr uint32_t no_entry = UINT32_MAX;
+static constexpr uint32_t erased   = UINT32_MAX - 1;
+
+static constexpr size_t min_capacity = 8;
+
+/*
+ * Whether a table with the given number of slots is too full to take one more
+ * entry. Slots of erased entries count, since probes have to step over them.
+ */
+static bool full(size_t used, size_t capacity) noexcept
+{
+    return (used + 1) * 4 > capacity * 3;
+}
+
+template <typename Entry>
+hash_table<Entry>::hash_table(span span) noexcept
+    : _span { span }
+{
+}
+
+template <typename Entry>
+size_t hash_table<Entry>::size() const noexcept
+{
+    return _size;
+}
+
+template <typename Entry>
+bool hash_table<Entry>::empty() const noexcept
+{
+    return _size == 0;
+}
+
+template <typename Entry>
+const std::vector<Entry>& hash_table<Entry>::entries() const noexcept
+{
+    return table().entries;
+}
+
+template <typename Entry>
+std::vector<Entry>& hash_table<Entry>::own_entries() noexcept
+{
+    return own().entries;
+}
+
+template <typename Entry>
+const typename hash_table<Entry>::storage&
+hash_table<Entry>::table() const noexcept
+{
+    static const storage nothing;
+    return _storage ? *_storage : nothing;
+}
+
+/*
+ * Make sure nothing else sees the entries and slots change, copying them if
+ * another table shares them. Empty tables get theirs here.
+ */
+template <typename Entry>
+typename hash_table<Entry>::storage& hash_table<Entry>::own() noexcept
+{
+    if (!_storage)
+    {
+        _storage = std::make_shared<storage>();
+    }
+    else if (_storage.use_count() > 1)
+    {
+        _storage = std::make_shared<storage>(*_storage);
+    }
+
+    return *_storage;
+}
+
+template <typename Entry>
+typename hash_table<Entry>::key_mode
+hash_table<Entry>::mode_of(const object& key) noexcept
+{
+    switch (key.type)
+    {
+    case object_type_number: return key_mode::numbers;
+    case object_type_string: return key_mode::strings;
+    default: return key_mode::any;
+    }
+}
+
+template <typename Entry>
+uint64_t hash_table<Entry>::hash_of(const object& key) const noexcept
+{
+    uint64_t bits = 0;
+
+    switch (_mode)
+    {
+    case key_mode::numbers:
+    {
+        /* 0 and -0 are equal, so they must hash the same. */
+        auto n = AS_NUMBER(key);
+        bits   = std::bit_cast<uint64_t>(n == 0 ? 0.0 : n);
+        break;
+    }
+    case key_mode::strings:
+    {
+        bits = key.box.as_int64;
+        break;
+    }
+    case key_mode::none:
+    case key_mode::any:
+    {
+        bits = hash(key);
+        break;
+    }
+    }
+
+    return robin_hood::hash_int(bits);
+}
+
+template <typename Entry>
+bool hash_table<Entry>::same(const Entry& e, const object& key) const noexcept
+{
+    switch (_mode)
+    {
+    case key_mode::numbers:
+    {
+        return nanbox_to_double(e.key) == AS_NUMBER(key);
+    }
+    case key_mode::strings:
+    {
+        return e.key.as_int64 == key.box.as_int64;
+    }
+    case key_mode::none:
+    case key_mode::any:
+    {
+        return equals({ e.key_type, _span, e.key }, key);
+    }
+    }
+
+    assert(0 && "unhandled case in hash_table::same");
+}
+
+/*
+ * Return the slot that refers to the entry for a key, or the size of the table
+ * if there is none.
+ */
+template <typename Entry>
+size_t hash_table<Entry>::probe(const object& key, uint64_t hash) const noexcept
+{
+    const auto& t = table();
+    auto mask     = t.slots.size() - 1;
+    auto tag      = static_cast<uint32_t>(hash >> 32);
+
+    for (auto i = hash & mask;; i = (i + 1) & mask)
+    {
+        const auto& s = t.slots[i];
+        if (s.index == no_entry) return t.slots.size();
+        if (s.index == erased || s.tag != tag) continue;
+        if (same(t.entries[s.index], key)) return i;
+    }
+}
+
+/*
+ * Return the first slot a new entry with the given hash can take.
+ */
+template <typename Entry>
+size_t hash_table<Entry>::vacancy(uint64_t hash) const noexcept
+{
+    const auto& slots = table().slots;
+    auto mask         = slots.size() - 1;
+
+    for (auto i = hash & mask;; i = (i + 1) & mask)
+    {
+        if (slots[i].index == no_entry || slots[i].index == erased) return i;
+    }
+}
+
+template <typename Entry>
+std::optional<size_t> hash_table<Entry>::find(const object& key) const noexcept
+{
+    /* A key the table has no mode for cannot be in it. */
+    if (_size == 0 || (_mode != key_mode::any && mode_of(key) != _mode))
+    {
+        return std::nullopt;
+    }
+
+    const auto& slots = table().slots;
+    auto at           = probe(key, hash_of(key));
+    if (at == slots.size()) return std::nullopt;
+
+    return slots[at].index;
+}
+
+template <typename Entry>
+bool hash_table<Entry>::contains(const object& key) const noexcept
+{
+    return find(key).has_value();
+}
+
+/*
+ * Get the table ready to take the given key, switching to hashing any kind of
+ * key if it does not fit the current mode, and making room for one more entry.
+ */
+template <typename Entry>
+void hash_table<Entry>::admit(const object& key) noexcept
+{
+    auto mode = mode_of(key);
+
+    if (_mode == key_mode::none)
+    {
+        _mode = mode;
+    }
+    else if (_mode != key_mode::any && mode != _mode)
+    {
+        _mode = key_mode::any;
+        rebuild(table().slots.size());
+    }
+
+    const auto& t = table();
+    if (full(t.entries.size(), t.slots.size()))
+    {
+        auto capacity = std::max(min_capacity, t.slots.size());
+        while (full(_size, capacity)) capacity *= 2;
+        rebuild(capacity);
+    }
+}
+
+template <typename Entry>
+std::pair<size_t, bool>
+hash_table<Entry>::emplace_key(interpreter& interp, const object& key) noexcept
+{
+    /*
+     * Only a new key may rebuild the table, so that setting one already there
+     * neither moves entries under cursors nor counts as a change.
+     */
+    if (auto index = find(key); index) return { *index, false };
+
+    admit(key);
+    auto hash = hash_of(key);
+
+    /* Tuples hash the same as arrays, so the hash still holds. */
+    auto stored = IS_ARRAY(key) ? create_tuple(interp, key.span, AS_ARRAY(key))
+                                : key;
+
+    auto& t                = own();
+    auto index             = t.entries.size();
+    t.slots[vacancy(hash)] = {
+        static_cast<uint32_t>(index),
+        static_cast<uint32_t>(hash >> 32),
+    };
+
+    Entry entry {};
+    entry.key      = stored.box;
+    entry.key_type = stored.type;
+    t.entries.push_back(entry);
+
+    _size += 1;
+    _changes += 1;
+
+    return { index, true };
+}
+
+template <typename Entry>
+void hash_table<Entry>::erase(size_t index) noexcept
+{
+    auto k  = key(index);
+    auto at = probe(k, hash_of(k));
+    assert(at != table().slots.size());
+
+    auto& t                   = own();
+    t.slots[at].index         = erased;
+    t.entries[index].key_type = object_type_invalid;
+
+    _size -= 1;
+    _changes += 1;
+
+    /* The slots of an empty table are all free again, and so is its mode. */
+    if (_size == 0)
+    {
+        t.entries.clear();
+        std::fill(t.slots.begin(), t.slots.end(), slot { no_entry, 0 });
+        _mode = key_mode::none;
+    }
+}
+
+template <typename Entry>
+object hash_table<Entry>::key(size_t index) const noexcept
+{
+    const auto& e = table().entries[index];
+    return { e.key_type, _span, e.key };
+}
+
+template <typename Entry>
+size_t hash_table<Entry>::changes() const noexcept
+{
+    return _changes;
+}
+
+template <typename Entry>
+size_t hash_table<Entry>::next_index(size_t index) const noexcept
+{
+    const auto& entries = table().entries;
+    while (index < entries.size()
+           && entries[index].key_type == object_type_invalid)
+    {
+        index++;
+    }
+
+    return index;
+}
+
+template <typename Entry>
+size_t hash_table<Entry>::end_index() const noexcept
+{
+    return table().entries.size();
+}
+
+/*
+ * Drop the holes left by erased entries and hash the rest again into a table
+ * with the given number of slots.
+ */
+template <typename Entry>
+void hash_table<Entry>::rebuild(size_t capacity) noexcept
+{
+    auto& t = own();
+    std::erase_if(t.entries, [](const Entry& e) {
+        return e.key_type == object_type_invalid;
+    });
+
+    t.slots.assign(capacity, slot { no_entry, 0 });
+
+    for (size_t i = 0; i < t.entries.size(); i++)
+    {
+        auto hash              = hash_of(key(i));
+        t.slots[vacancy(hash)] = {
+            static_cast<uint32_t>(i),
+            static_cast<uint32_t>(hash >> 32),
+        };
+    }
+
+    _changes += 1;
+}
+
+template class hash_table<dictionary_entry>;
+template class hash_table<set_entry>;
+
+}
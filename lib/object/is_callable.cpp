@@ -12,12 +12,18 @@ bool is_callable(const object& o) noexcept
     case object_type_unit:
     case object_type_sequence:
     case object_type_enum:
+    case object_type_set:
+    case object_type_priority_queue:
     {
         return false;
     }
     case object_type_string:
     case object_type_array:
     case object_type_dictionary:
+    case object_type_tuple:
+    case object_type_deque:
+    case object_type_grid:
+    case object_type_typed_array:
     case object_type_function:
     case object_type_builtin_function:
     case object_type_struct:
@@ -17,6 +17,12 @@ bool is_comparable(const object& o) noexcept
     }
     case object_type_array:
     case object_type_dictionary:
+    case object_type_tuple:
+    case object_type_set:
+    case object_type_priority_queue:
+    case object_type_deque:
+    case object_type_grid:
+    case object_type_typed_array:
     case object_type_function:
     case object_type_builtin_function:
     case object_type_sequence:
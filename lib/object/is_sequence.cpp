@@ -13,6 +13,10 @@ bool is_sequence(const object& o) noexcept
     case object_type_string:
     case object_type_array:
     case object_type_dictionary:
+    case object_type_tuple:
+    case object_type_set:
+    case object_type_deque:
+    case object_type_typed_array:
     {
         return true;
     }
@@ -20,6 +24,8 @@ bool is_sequence(const object& o) noexcept
     case object_type_builtin_function:
     case object_type_struct:
     case object_type_enum:
+    case object_type_priority_queue:
+    case object_type_grid:
     {
         return false;
     }
@@ -29,6 +29,30 @@ bool is_truthy(const object& o) noexcept
     {
         return !AS_DICT(o).empty();
     }
+    case object_type_tuple:
+    {
+        return !AS_TUPLE(o).empty();
+    }
+    case object_type_set:
+    {
+        return !AS_SET(o).empty();
+    }
+    case object_type_priority_queue:
+    {
+        return !AS_PRIORITY_QUEUE(o).empty();
+    }
+    case object_type_deque:
+    {
+        return !AS_DEQUE(o).empty();
+    }
+    case object_type_grid:
+    {
+        return AS_GRID(o).size() > 0;
+    }
+    case object_type_typed_array:
+    {
+        return !AS_TYPED_ARRAY(o).empty();
+    }
     case object_type_function:
     case object_type_builtin_function:
     case object_type_enum:
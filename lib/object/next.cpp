@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <variant>
 
 #include <nanbox.h>
 
+#include <eval.hpp>
+#include <generator.hpp>
 #include <object.hpp>
 
 namespace gaya::eval::object
@@ -25,9 +30,50 @@ object string_sequence_next(
 
 object array_sequence_next(span span, array_sequence& seq) noexcept
 {
-    if (seq.index < seq.elems.size())
+    const auto& array = AS_ARRAY(seq.array);
+    if (seq.index < array.size())
     {
-        return seq.elems[seq.index++];
+        return array[seq.index++];
+    }
+    else
+    {
+        return create_unit(span);
+    }
+}
+
+object tuple_sequence_next(span span, tuple_sequence& seq) noexcept
+{
+    const auto& t = AS_TUPLE(seq.tuple);
+    if (seq.index < t.size())
+    {
+        return t[seq.index++];
+    }
+    else
+    {
+        return create_unit(span);
+    }
+}
+
+object deque_sequence_next(span span, deque_sequence& seq) noexcept
+{
+    const auto& deque = AS_DEQUE(seq.deque);
+    if (seq.index < deque.size())
+    {
+        return deque[seq.index++];
+    }
+    else
+    {
+        return create_unit(span);
+    }
+}
+
+object
+typed_array_sequence_next(span span, typed_array_sequence& seq) noexcept
+{
+    const auto& array = AS_TYPED_ARRAY(seq.array);
+    if (seq.index < array.size())
+    {
+        return create_number(span, array.at(seq.index++));
     }
     else
     {
@@ -52,19 +98,363 @@ object user_sequence_next(span span, user_defined_sequence& seq) noexcept
     return call(seq.next_func, seq.interp, span, {});
 }
 
+/*
+ * Report an error if keys were added to or removed from the dictionary under a
+ * cursor, which may have moved its entries around.
+ */
+static bool dict_changed(
+    interpreter& interp,
+    span span,
+    const dict_sequence& seq) noexcept
+{
+    if (AS_DICT(seq.dict).changes() == seq.changes) return false;
+
+    interp.interp_error(span, "Dictionary changed during iteration");
+    return true;
+}
+
+static object
+dict_entry(interpreter& interp, span span, const dict_sequence& seq) noexcept
+{
+    const auto& dict = AS_DICT(seq.dict);
+
+    switch (seq.kind)
+    {
+    case dict_sequence_keys: return dict.key(seq.index);
+    case dict_sequence_values: return dict.value(seq.index);
+    case dict_sequence_items:
+    {
+        std::vector<object> pair { dict.key(seq.index), dict.value(seq.index) };
+        return create_array(interp, span, std::move(pair));
+    }
+    }
+
+    assert(0 && "unhandled case in dict_entry");
+}
+
 object
 dict_sequence_next(interpreter& interp, span span, dict_sequence& seq) noexcept
 {
-    if (seq.i < seq.keys.size())
+    if (dict_changed(interp, span, seq)) return invalid;
+
+    const auto& dict = AS_DICT(seq.dict);
+    if (seq.index >= dict.end_index()) return create_unit(span);
+
+    auto entry = dict_entry(interp, span, seq);
+    seq.index  = dict.next_index(seq.index + 1);
+    return entry;
+}
+
+/*
+ * Report an error if elements were added to or removed from the set under a
+ * cursor.
+ */
+static bool
+set_changed(interpreter& interp, span span, const set_sequence& seq) noexcept
+{
+    if (AS_SET(seq.set).changes() == seq.changes) return false;
+
+    interp.interp_error(span, "Set changed during iteration");
+    return true;
+}
+
+object
+set_sequence_next(interpreter& interp, span span, set_sequence& seq) noexcept
+{
+    if (set_changed(interp, span, seq)) return invalid;
+
+    const auto& set = AS_SET(seq.set);
+    if (seq.index >= set.end_index()) return create_unit(span);
+
+    auto x    = set.key(seq.index);
+    seq.index = set.next_index(seq.index + 1);
+    return x;
+}
+
+size_t find_separator(
+    std::string_view s,
+    std::string_view separator,
+    size_t pos) noexcept
+{
+    if (pos >= s.size()) return std::string_view::npos;
+
+    const auto* start = s.data() + pos;
+    const auto* found = separator.size() == 1
+        ? std::memchr(start, separator[0], s.size() - pos)
+        : memmem(start, s.size() - pos, separator.data(), separator.size());
+
+    if (!found) return std::string_view::npos;
+
+    return static_cast<const char*>(found) - s.data();
+}
+
+object split_sequence_next(
+    interpreter& interp,
+    span span,
+    split_sequence& seq) noexcept
+{
+    std::string_view s = AS_STRING(seq.string);
+
+    if (seq.separator.empty())
     {
-        std::vector<object> pair { seq.keys[seq.i], seq.values[seq.i] };
-        seq.i += 1;
-        return create_array(interp, span, std::move(pair));
+        if (seq.index < s.size())
+        {
+            return create_string(interp, span, s.substr(seq.index++, 1));
+        }
+        return create_unit(span);
+    }
+
+    if (seq.done)
+    {
+        return create_unit(span);
+    }
+
+    auto start = seq.index;
+    auto end   = find_separator(s, seq.separator, start);
+
+    if (end == std::string_view::npos)
+    {
+        seq.done = true;
+        end      = s.size();
     }
     else
+    {
+        seq.index = end + seq.separator.size();
+    }
+
+    return create_string(interp, span, s.substr(start, end - start));
+}
+
+object lines_sequence_next(
+    interpreter& interp,
+    span span,
+    lines_sequence& seq) noexcept
+{
+    /*
+     * NOTE: Lines are interned and never freed like any other string, so
+     *       reading a file of distinct lines keeps all of them in memory.
+     */
+    auto line = seq.chunks ? seq.reader->next_chunk() : seq.reader->next();
+    if (line)
+    {
+        return create_string(interp, span, *line);
+    }
+
+    return create_unit(span);
+}
+
+/*
+ * Whether an element returned by next marks the end of a sequence, either
+ * because it is done or because an error happened.
+ */
+static bool is_end(object& o) noexcept
+{
+    return !is_valid(o) || IS_UNIT(o);
+}
+
+object
+map_sequence_next(interpreter& interp, span span, map_sequence& seq) noexcept
+{
+    auto x = next(interp, span, seq.inner);
+    if (is_end(x)) return x;
+
+    return call(seq.func, interp, span, { x });
+}
+
+object filter_sequence_next(
+    interpreter& interp,
+    span span,
+    filter_sequence& seq) noexcept
+{
+    for (;;)
+    {
+        auto x = next(interp, span, seq.inner);
+        if (is_end(x)) return x;
+
+        auto keep = call(seq.pred, interp, span, { x });
+        if (!is_valid(keep)) return keep;
+        if (is_truthy(keep)) return x;
+    }
+}
+
+object unique_sequence_next(
+    interpreter& interp,
+    span span,
+    unique_sequence& seq) noexcept
+{
+    for (;;)
+    {
+        auto x = next(interp, span, seq.inner);
+        if (is_end(x)) return x;
+        if (seq.seen.insert(x).second) return x;
+    }
+}
+
+object
+take_sequence_next(interpreter& interp, span span, take_sequence& seq) noexcept
+{
+    if (seq.remaining <= 0)
     {
         return create_unit(span);
     }
+
+    seq.remaining -= 1;
+    return next(interp, span, seq.inner);
+}
+
+/*
+ * Skip the elements a drop sequence still has to drop at once, if the
+ * sequence it reads from can do that.
+ */
+static void skip_dropped(drop_sequence& seq) noexcept
+{
+    if (seq.remaining <= 0) return;
+
+    auto dropped = static_cast<size_t>(std::ceil(seq.remaining));
+    if (skip(seq.inner, dropped)) seq.remaining = 0;
+}
+
+object
+drop_sequence_next(interpreter& interp, span span, drop_sequence& seq) noexcept
+{
+    skip_dropped(seq);
+
+    for (; seq.remaining > 0; seq.remaining -= 1)
+    {
+        auto x = next(interp, span, seq.inner);
+        if (is_end(x))
+        {
+            seq.remaining = 0;
+            return x;
+        }
+    }
+
+    return next(interp, span, seq.inner);
+}
+
+object takewhile_sequence_next(
+    interpreter& interp,
+    span span,
+    takewhile_sequence& seq) noexcept
+{
+    if (seq.done)
+    {
+        return create_unit(span);
+    }
+
+    auto x = next(interp, span, seq.inner);
+    if (is_end(x)) return x;
+
+    auto keep = call(seq.pred, interp, span, { x });
+    if (!is_valid(keep)) return keep;
+
+    if (!is_truthy(keep))
+    {
+        seq.done = true;
+        return create_unit(span);
+    }
+
+    return x;
+}
+
+object dropwhile_sequence_next(
+    interpreter& interp,
+    span span,
+    dropwhile_sequence& seq) noexcept
+{
+    auto x = next(interp, span, seq.inner);
+
+    while (seq.dropping && !is_end(x))
+    {
+        auto drop = call(seq.pred, interp, span, { x });
+        if (!is_valid(drop)) return drop;
+
+        if (!is_truthy(drop))
+        {
+            seq.dropping = false;
+            break;
+        }
+
+        x = next(interp, span, seq.inner);
+    }
+
+    return x;
+}
+
+object enumerate_sequence_next(
+    interpreter& interp,
+    span span,
+    enumerate_sequence& seq) noexcept
+{
+    auto x = next(interp, span, seq.inner);
+    if (is_end(x)) return x;
+
+    std::vector<object> pair { create_number(span, seq.index), x };
+    seq.index += 1;
+    return create_array(interp, span, std::move(pair));
+}
+
+object flatten_sequence_next(
+    interpreter& interp,
+    span span,
+    flatten_sequence& seq) noexcept
+{
+    for (;;)
+    {
+        auto y = next(interp, span, seq.current);
+        if (!IS_UNIT(y)) return y;
+
+        auto ys = next(interp, span, seq.inner);
+        if (is_end(ys)) return ys;
+
+        if (!is_sequence(ys))
+        {
+            interp.interp_error(
+                span,
+                "Expected the elements of the flattened sequence to be "
+                "sequences");
+            return invalid;
+        }
+
+        seq.current = to_sequence(interp, ys);
+    }
+}
+
+object segments_sequence_next(
+    interpreter& interp,
+    span span,
+    segments_sequence& seq) noexcept
+{
+    if (seq.i > seq.length)
+    {
+        return create_unit(span);
+    }
+
+    array_sequence segment = { seq.elems, seq.suffixes ? seq.i : 0 };
+    auto xs                = create_sequence(
+        interp,
+        sequence { span, sequence_type_array, segment });
+
+    if (!seq.suffixes)
+    {
+        take_sequence prefix = { xs, static_cast<double>(seq.i) };
+        xs                   = create_sequence(
+            interp,
+            sequence { span, sequence_type_take, prefix });
+    }
+
+    seq.i += 1;
+    return xs;
+}
+
+object next(interpreter& interp, span span, object& xs) noexcept
+{
+    if (!IS_SEQUENCE(xs))
+    {
+        return create_unit(span);
+    }
+
+    return next(interp, AS_SEQUENCE(xs));
 }
 
 object next(interpreter& interp, sequence& seq) noexcept
@@ -96,6 +486,24 @@ object next(interpreter& interp, sequence& seq) noexcept
             seq.seq_span,
             std::get<array_sequence>(seq.seq));
     }
+    case sequence_type_tuple:
+    {
+        return tuple_sequence_next(
+            seq.seq_span,
+            std::get<tuple_sequence>(seq.seq));
+    }
+    case sequence_type_deque:
+    {
+        return deque_sequence_next(
+            seq.seq_span,
+            std::get<deque_sequence>(seq.seq));
+    }
+    case sequence_type_typed_array:
+    {
+        return typed_array_sequence_next(
+            seq.seq_span,
+            std::get<typed_array_sequence>(seq.seq));
+    }
     case sequence_type_dict:
     {
         return dict_sequence_next(
@@ -103,9 +511,606 @@ object next(interpreter& interp, sequence& seq) noexcept
             seq.seq_span,
             std::get<dict_sequence>(seq.seq));
     }
+    case sequence_type_set:
+    {
+        return set_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<set_sequence>(seq.seq));
+    }
+    case sequence_type_split:
+    {
+        return split_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<split_sequence>(seq.seq));
+    }
+    case sequence_type_lines:
+    {
+        return lines_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<lines_sequence>(seq.seq));
+    }
+    case sequence_type_map:
+    {
+        return map_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<map_sequence>(seq.seq));
+    }
+    case sequence_type_filter:
+    {
+        return filter_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<filter_sequence>(seq.seq));
+    }
+    case sequence_type_take:
+    {
+        return take_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<take_sequence>(seq.seq));
+    }
+    case sequence_type_drop:
+    {
+        return drop_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<drop_sequence>(seq.seq));
+    }
+    case sequence_type_takewhile:
+    {
+        return takewhile_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<takewhile_sequence>(seq.seq));
+    }
+    case sequence_type_dropwhile:
+    {
+        return dropwhile_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<dropwhile_sequence>(seq.seq));
+    }
+    case sequence_type_enumerate:
+    {
+        return enumerate_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<enumerate_sequence>(seq.seq));
+    }
+    case sequence_type_flatten:
+    {
+        return flatten_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<flatten_sequence>(seq.seq));
+    }
+    case sequence_type_segments:
+    {
+        return segments_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<segments_sequence>(seq.seq));
+    }
+    case sequence_type_tee:
+    {
+        auto& tee_seq = std::get<tee_sequence>(seq.seq);
+        return tee_seq.buffer->next(interp, seq.seq_span, tee_seq.cursor);
+    }
+    case sequence_type_generator:
+    {
+        auto& generator_seq = std::get<generator_sequence>(seq.seq);
+        return generator_seq.state->resume(interp, seq.seq_span);
+    }
+    case sequence_type_unique:
+    {
+        return unique_sequence_next(
+            interp,
+            seq.seq_span,
+            std::get<unique_sequence>(seq.seq));
+    }
     }
 
     assert(0 && "unhandled case in next");
 }
 
+bool can_prefetch(const object& xs) noexcept
+{
+    return !IS_SEQUENCE(xs) || can_prefetch(AS_SEQUENCE(xs));
+}
+
+bool can_prefetch(const sequence& seq) noexcept
+{
+    switch (seq.type)
+    {
+    case sequence_type_string:
+    case sequence_type_number:
+    case sequence_type_split:
+    case sequence_type_tuple:
+    {
+        return true;
+    }
+    case sequence_type_take:
+    {
+        return can_prefetch(std::get<take_sequence>(seq.seq).inner);
+    }
+    case sequence_type_drop:
+    {
+        return can_prefetch(std::get<drop_sequence>(seq.seq).inner);
+    }
+    case sequence_type_enumerate:
+    {
+        return can_prefetch(std::get<enumerate_sequence>(seq.seq).inner);
+    }
+    case sequence_type_unique:
+    {
+        return can_prefetch(std::get<unique_sequence>(seq.seq).inner);
+    }
+    /*
+     * NOTE: Arrays, deques, typed arrays, dictionaries and sets can be
+     *       modified while they are being iterated, and reading ahead of a
+     *       lines sequence would take input that may be meant for another
+     *       reader of the same file descriptor.
+     */
+    case sequence_type_array:
+    case sequence_type_deque:
+    case sequence_type_typed_array:
+    case sequence_type_dict:
+    case sequence_type_set:
+    case sequence_type_lines:
+    case sequence_type_user:
+    case sequence_type_map:
+    case sequence_type_filter:
+    case sequence_type_takewhile:
+    case sequence_type_dropwhile:
+    case sequence_type_flatten:
+    case sequence_type_segments:
+    case sequence_type_tee:
+    case sequence_type_generator:
+    {
+        return false;
+    }
+    }
+
+    assert(0 && "unhandled case in can_prefetch");
+}
+
+bool can_read_ahead(const object& given, const object& xs) noexcept
+{
+    return !IS_SEQUENCE(given) && can_prefetch(xs);
+}
+
+/*
+ * Fill the batch by calling next repeatedly, for sequences that have no better
+ * way of doing it.
+ */
+static size_t next_batch_one_by_one(
+    interpreter& interp,
+    sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        auto x = next(interp, seq);
+        if (IS_UNIT(x)) return i;
+
+        out[i] = x;
+        if (!is_valid(x)) return i + 1;
+    }
+
+    return n;
+}
+
+static size_t
+array_sequence_next_batch(array_sequence& seq, object* out, size_t n) noexcept
+{
+    const auto& array = AS_ARRAY(seq.array);
+
+    size_t i = 0;
+    for (; i < n && seq.index < array.size(); i++)
+    {
+        out[i] = array[seq.index++];
+    }
+    return i;
+}
+
+static size_t
+tuple_sequence_next_batch(tuple_sequence& seq, object* out, size_t n) noexcept
+{
+    const auto& t = AS_TUPLE(seq.tuple);
+
+    size_t i = 0;
+    for (; i < n && seq.index < t.size(); i++)
+    {
+        out[i] = t[seq.index++];
+    }
+    return i;
+}
+
+static size_t
+deque_sequence_next_batch(deque_sequence& seq, object* out, size_t n) noexcept
+{
+    const auto& deque = AS_DEQUE(seq.deque);
+
+    size_t i = 0;
+    for (; i < n && seq.index < deque.size(); i++)
+    {
+        out[i] = deque[seq.index++];
+    }
+    return i;
+}
+
+static size_t typed_array_sequence_next_batch(
+    span span,
+    typed_array_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    const auto& array = AS_TYPED_ARRAY(seq.array);
+
+    size_t i = 0;
+    for (; i < n && seq.index < array.size(); i++)
+    {
+        out[i] = create_number(span, array.at(seq.index++));
+    }
+    return i;
+}
+
+static size_t number_sequence_next_batch(
+    span span,
+    number_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    size_t i = 0;
+    for (; i < n && seq.i < seq.upto; i++)
+    {
+        out[i] = create_number(span, seq.i++);
+    }
+    return i;
+}
+
+static size_t string_sequence_next_batch(
+    interpreter& interp,
+    span span,
+    string_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    std::string_view s = seq.string;
+
+    size_t i = 0;
+    for (; i < n && seq.index < s.size(); i++)
+    {
+        out[i] = create_string(interp, span, s.substr(seq.index++, 1));
+    }
+    return i;
+}
+
+static size_t dict_sequence_next_batch(
+    interpreter& interp,
+    span span,
+    dict_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    if (n == 0) return 0;
+
+    if (dict_changed(interp, span, seq))
+    {
+        out[0] = invalid;
+        return 1;
+    }
+
+    const auto& dict = AS_DICT(seq.dict);
+
+    size_t i = 0;
+    for (; i < n && seq.index < dict.end_index(); i++)
+    {
+        out[i]    = dict_entry(interp, span, seq);
+        seq.index = dict.next_index(seq.index + 1);
+    }
+    return i;
+}
+
+static size_t set_sequence_next_batch(
+    interpreter& interp,
+    span span,
+    set_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    if (n == 0) return 0;
+
+    if (set_changed(interp, span, seq))
+    {
+        out[0] = invalid;
+        return 1;
+    }
+
+    const auto& set = AS_SET(seq.set);
+
+    size_t i = 0;
+    for (; i < n && seq.index < set.end_index(); i++)
+    {
+        out[i]    = set.key(seq.index);
+        seq.index = set.next_index(seq.index + 1);
+    }
+    return i;
+}
+
+static size_t map_sequence_next_batch(
+    interpreter& interp,
+    span span,
+    map_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    auto count = next_batch(interp, seq.inner, out, n);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!is_valid(out[i])) return i + 1;
+
+        out[i] = call(seq.func, interp, span, { out[i] });
+        if (!is_valid(out[i])) return i + 1;
+        if (IS_UNIT(out[i])) return i;
+    }
+
+    return count;
+}
+
+static size_t filter_sequence_next_batch(
+    interpreter& interp,
+    span span,
+    filter_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    size_t kept = 0;
+
+    while (kept < n)
+    {
+        auto wanted = n - kept;
+        auto count  = next_batch(interp, seq.inner, out + kept, wanted);
+        auto end    = kept + count;
+
+        for (size_t i = kept; i < end; i++)
+        {
+            if (!is_valid(out[i]))
+            {
+                out[kept] = out[i];
+                return kept + 1;
+            }
+
+            auto keep = call(seq.pred, interp, span, { out[i] });
+            if (!is_valid(keep))
+            {
+                out[kept] = keep;
+                return kept + 1;
+            }
+
+            if (is_truthy(keep))
+            {
+                out[kept++] = out[i];
+            }
+        }
+
+        if (count < wanted) break;
+    }
+
+    return kept;
+}
+
+static size_t take_sequence_next_batch(
+    interpreter& interp,
+    take_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    if (seq.remaining <= 0) return 0;
+
+    auto wanted = static_cast<size_t>(
+        std::min(static_cast<double>(n), std::ceil(seq.remaining)));
+    auto count = next_batch(interp, seq.inner, out, wanted);
+    seq.remaining -= static_cast<double>(count);
+    return count;
+}
+
+static size_t enumerate_sequence_next_batch(
+    interpreter& interp,
+    span span,
+    enumerate_sequence& seq,
+    object* out,
+    size_t n) noexcept
+{
+    auto count = next_batch(interp, seq.inner, out, n);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!is_valid(out[i])) return i + 1;
+
+        std::vector<object> pair { create_number(span, seq.index), out[i] };
+        seq.index += 1;
+        out[i] = create_array(interp, span, std::move(pair));
+    }
+
+    return count;
+}
+
+size_t
+next_batch(interpreter& interp, object& xs, object* out, size_t n) noexcept
+{
+    if (!IS_SEQUENCE(xs)) return 0;
+
+    return next_batch(interp, AS_SEQUENCE(xs), out, n);
+}
+
+size_t
+next_batch(interpreter& interp, sequence& seq, object* out, size_t n) noexcept
+{
+    auto span = seq.seq_span;
+
+    switch (seq.type)
+    {
+    case sequence_type_array:
+    {
+        return array_sequence_next_batch(
+            std::get<array_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_tuple:
+    {
+        return tuple_sequence_next_batch(
+            std::get<tuple_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_deque:
+    {
+        return deque_sequence_next_batch(
+            std::get<deque_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_typed_array:
+    {
+        return typed_array_sequence_next_batch(
+            span,
+            std::get<typed_array_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_number:
+    {
+        return number_sequence_next_batch(
+            span,
+            std::get<number_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_string:
+    {
+        return string_sequence_next_batch(
+            interp,
+            span,
+            std::get<string_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_dict:
+    {
+        return dict_sequence_next_batch(
+            interp,
+            span,
+            std::get<dict_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_set:
+    {
+        return set_sequence_next_batch(
+            interp,
+            span,
+            std::get<set_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_map:
+    {
+        auto& map_seq = std::get<map_sequence>(seq.seq);
+        if (!map_seq.batched) break;
+        return map_sequence_next_batch(interp, span, map_seq, out, n);
+    }
+    case sequence_type_filter:
+    {
+        auto& filter_seq = std::get<filter_sequence>(seq.seq);
+        if (!filter_seq.batched) break;
+        return filter_sequence_next_batch(interp, span, filter_seq, out, n);
+    }
+    case sequence_type_take:
+    {
+        return take_sequence_next_batch(
+            interp,
+            std::get<take_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_enumerate:
+    {
+        return enumerate_sequence_next_batch(
+            interp,
+            span,
+            std::get<enumerate_sequence>(seq.seq),
+            out,
+            n);
+    }
+    case sequence_type_drop:
+    {
+        auto& drop_seq = std::get<drop_sequence>(seq.seq);
+        skip_dropped(drop_seq);
+        if (drop_seq.remaining > 0) break;
+        return next_batch(interp, drop_seq.inner, out, n);
+    }
+    case sequence_type_user:
+    case sequence_type_split:
+    case sequence_type_lines:
+    case sequence_type_takewhile:
+    case sequence_type_dropwhile:
+    case sequence_type_flatten:
+    case sequence_type_segments:
+    case sequence_type_tee:
+    case sequence_type_generator:
+    case sequence_type_unique:
+    {
+        break;
+    }
+    }
+
+    /*
+     * NOTE: Callbacks must see the elements in the same order they would if
+     *       they were pulled one at a time, so adaptors that run code only
+     *       batch the sequences they read from if those can be prefetched.
+     */
+    return next_batch_one_by_one(interp, seq, out, n);
+}
+
+sequence_reader::sequence_reader(
+    interpreter& interp,
+    span span,
+    object xs,
+    bool batched) noexcept
+    : _interp { interp }
+    , _span { span }
+    , _xs { xs }
+    , _batched { batched }
+{
+    if (_batched)
+    {
+        _batch.resize(sequence_batch_size, invalid);
+    }
+}
+
+object sequence_reader::refill() noexcept
+{
+    if (!_batched)
+    {
+        return gaya::eval::object::next(_interp, _span, _xs);
+    }
+
+    _index = 0;
+    _count = next_batch(_interp, _xs, _batch.data(), _batch.size());
+    if (_count == 0)
+    {
+        return create_unit(_span);
+    }
+
+    return _batch[_index++];
+}
+
 }
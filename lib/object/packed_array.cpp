@@ -0,0 +1,173 @@
+#include <cassert>
+
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+packed_array::packed_array(span span) noexcept
+    : _span { span }
+{
+}
+
+packed_array::packed_array(span span, const std::vector<object>& elems) noexcept
+    : _span { span }
+{
+    own();
+    _buffer->boxes.reserve(elems.size());
+    for (const auto& elem : elems) push_back(elem);
+}
+
+size_t packed_array::size() const noexcept
+{
+    return _size;
+}
+
+bool packed_array::empty() const noexcept
+{
+    return _size == 0;
+}
+
+packed_array packed_array::slice(size_t start, size_t end) const noexcept
+{
+    assert(start <= end && end <= _size);
+
+    auto view = *this;
+    view._offset += start;
+    view._size = end - start;
+    return view;
+}
+
+object packed_array::operator[](size_t index) const noexcept
+{
+    auto i    = _offset + index;
+    auto type = _mixed ? static_cast<object_type>(_buffer->types[i]) : _kind;
+    return { type, _span, _buffer->boxes[i] };
+}
+
+/*
+ * Make sure nothing else sees the buffer change, copying the window of this
+ * array out of it if it is shared. A buffer the array alone has is changed
+ * in place as long as the window reaches its end.
+ */
+void packed_array::own() noexcept
+{
+    if (!_buffer)
+    {
+        _buffer = std::make_shared<buffer>();
+        return;
+    }
+
+    auto end = _offset + _size;
+    if (_buffer.use_count() == 1 && end == _buffer->boxes.size()) return;
+
+    auto copy        = std::make_shared<buffer>();
+    const auto& from = *_buffer;
+    copy->boxes.assign(from.boxes.begin() + _offset, from.boxes.begin() + end);
+    if (_mixed)
+    {
+        copy->types.assign(
+            from.types.begin() + _offset,
+            from.types.begin() + end);
+    }
+
+    _buffer = std::move(copy);
+    _offset = 0;
+}
+
+/*
+ * Keep the type of each element from now on, since they are about to stop
+ * being all the same. The buffer must be owned.
+ */
+void packed_array::widen() noexcept
+{
+    auto& b = *_buffer;
+    b.types.assign(b.boxes.size(), static_cast<unsigned char>(_kind));
+    b.types.reserve(b.boxes.capacity());
+    _mixed = true;
+}
+
+void packed_array::set(size_t index, const object& o) noexcept
+{
+    assert(index < _size);
+
+    own();
+    if (!_mixed && o.type != _kind) widen();
+    if (_mixed)
+    {
+        _buffer->types[_offset + index] = static_cast<unsigned char>(o.type);
+    }
+
+    _buffer->boxes[_offset + index] = o.box;
+}
+
+void packed_array::push_back(const object& o) noexcept
+{
+    own();
+    if (_size == 0 && !_mixed) _kind = o.type;
+    if (!_mixed && o.type != _kind) widen();
+    if (_mixed) _buffer->types.push_back(static_cast<unsigned char>(o.type));
+
+    _buffer->boxes.push_back(o.box);
+    _size++;
+}
+
+void packed_array::append(const packed_array& other) noexcept
+{
+    /* Holding on to the other array makes this one copy its elements out
+     * first if they share a buffer, so appending an array to itself works. */
+    auto source = other;
+    own();
+
+    if (!_mixed && !source._mixed && (empty() || _kind == source._kind))
+    {
+        if (source.empty()) return;
+
+        if (empty()) _kind = source._kind;
+        auto& boxes = _buffer->boxes;
+        auto first  = source._buffer->boxes.begin() + source._offset;
+        boxes.insert(boxes.end(), first, first + source._size);
+        _size += source._size;
+        return;
+    }
+
+    _buffer->boxes.reserve(_buffer->boxes.size() + source.size());
+    for (size_t i = 0; i < source.size(); i++) push_back(source[i]);
+}
+
+void packed_array::pop_back() noexcept
+{
+    assert(_size > 0);
+
+    /* A shared buffer stays as it is, and only the window gets shorter. */
+    auto& b = *_buffer;
+    if (_buffer.use_count() == 1 && _offset + _size == b.boxes.size())
+    {
+        b.boxes.pop_back();
+        if (_mixed) b.types.pop_back();
+    }
+    _size--;
+}
+
+std::optional<object_type> packed_array::kind() const noexcept
+{
+    if (_mixed || _size == 0) return std::nullopt;
+
+    return _kind;
+}
+
+nanbox_t packed_array::box(size_t index) const noexcept
+{
+    return _buffer->boxes[_offset + index];
+}
+
+std::vector<object> packed_array::to_vector() const noexcept
+{
+    std::vector<object> elems;
+    elems.reserve(size());
+    for (size_t i = 0; i < size(); i++) elems.push_back((*this)[i]);
+
+    return elems;
+}
+
+}
@@ -0,0 +1,180 @@
+#include <cassert>
+#include <cmath>
+
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+/*
+ * A handle is the index of a slot plus its generation times 2^32. Handles go
+ * out as numbers, so generations stop where doubles stop being exact and a
+ * slot that gets there is no longer reused.
+ */
+static constexpr double slot_count    = 4294967296.0;
+static constexpr uint32_t generations = 1u << 21;
+
+static size_t make_handle(uint32_t slot, uint32_t generation) noexcept
+{
+    return static_cast<size_t>(generation) << 32 | slot;
+}
+
+priority_queue::priority_queue(span span) noexcept
+    : _span { span }
+{
+}
+
+size_t priority_queue::size() const noexcept
+{
+    return _heap.size();
+}
+
+bool priority_queue::empty() const noexcept
+{
+    return _heap.empty();
+}
+
+/*
+ * Whether a node comes out before another one. Ties go to the node pushed
+ * first.
+ */
+bool priority_queue::before(const node& a, const node& b) noexcept
+{
+    if (a.priority != b.priority) return a.priority < b.priority;
+    return a.order < b.order;
+}
+
+void priority_queue::place(size_t position, const node& n) noexcept
+{
+    _heap[position]         = n;
+    _slots[n.slot].position = static_cast<uint32_t>(position);
+}
+
+/*
+ * Move a node up from a position whose parents may come after it. The node is
+ * only written once, where it ends up.
+ */
+void priority_queue::sift_up(size_t position, node n) noexcept
+{
+    while (position > 0)
+    {
+        auto parent = (position - 1) / arity;
+        if (!before(n, _heap[parent])) break;
+
+        place(position, _heap[parent]);
+        position = parent;
+    }
+
+    place(position, n);
+}
+
+/*
+ * Move a node down from a position whose children may come before it.
+ */
+void priority_queue::sift_down(size_t position, node n) noexcept
+{
+    auto size = _heap.size();
+
+    for (;;)
+    {
+        auto first = position * arity + 1;
+        if (first >= size) break;
+
+        auto last = std::min(first + arity, size);
+        auto best = first;
+        for (auto child = first + 1; child < last; child++)
+        {
+            if (before(_heap[child], _heap[best])) best = child;
+        }
+
+        if (!before(_heap[best], n)) break;
+
+        place(position, _heap[best]);
+        position = best;
+    }
+
+    place(position, n);
+}
+
+size_t priority_queue::push(double priority, const object& value) noexcept
+{
+    uint32_t index;
+    if (_free_slots.empty())
+    {
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.push_back({ value.box, value.type, 0, 0 });
+    }
+    else
+    {
+        index = _free_slots.back();
+        _free_slots.pop_back();
+        _slots[index].value = value.box;
+        _slots[index].type  = value.type;
+    }
+
+    _heap.emplace_back();
+    sift_up(_heap.size() - 1, { priority, _pushes++, index });
+
+    return make_handle(index, _slots[index].generation);
+}
+
+object priority_queue::top() const noexcept
+{
+    assert(!_heap.empty());
+
+    const auto& s = _slots[_heap.front().slot];
+    return { s.type, _span, s.value };
+}
+
+double priority_queue::top_priority() const noexcept
+{
+    assert(!_heap.empty());
+
+    return _heap.front().priority;
+}
+
+void priority_queue::pop() noexcept
+{
+    assert(!_heap.empty());
+
+    auto index = _heap.front().slot;
+    if (++_slots[index].generation < generations)
+    {
+        _free_slots.push_back(index);
+    }
+
+    auto last = _heap.back();
+    _heap.pop_back();
+    if (!_heap.empty()) sift_down(0, last);
+}
+
+bool priority_queue::decrease(size_t handle, double priority) noexcept
+{
+    const auto& s = _slots[static_cast<uint32_t>(handle)];
+    if (s.generation != handle >> 32) return false;
+
+    auto n = _heap[s.position];
+    if (!(priority < n.priority)) return false;
+
+    n.priority = priority;
+    sift_up(s.position, n);
+    return true;
+}
+
+bool priority_queue::valid_handle(double handle) const noexcept
+{
+    if (handle < 0 || std::floor(handle) != handle) return false;
+
+    auto slot       = std::fmod(handle, slot_count);
+    auto generation = std::floor(handle / slot_count);
+    return slot < static_cast<double>(_slots.size()) && generation < generations
+        && generation <= _slots[static_cast<size_t>(slot)].generation;
+}
+
+object priority_queue::operator[](size_t position) const noexcept
+{
+    const auto& s = _slots[_heap[position].slot];
+    return { s.type, _span, s.value };
+}
+
+}
@@ -0,0 +1,110 @@
+#include <cassert>
+
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+static constexpr size_t min_capacity = 8;
+
+ring_buffer::ring_buffer(span span) noexcept
+    : _span { span }
+{
+}
+
+size_t ring_buffer::size() const noexcept
+{
+    return _size;
+}
+
+bool ring_buffer::empty() const noexcept
+{
+    return _size == 0;
+}
+
+/*
+ * The slot of the buffer that holds the element at an index from the front.
+ */
+size_t ring_buffer::slot(size_t index) const noexcept
+{
+    return (_head + index) & (_elements.size() - 1);
+}
+
+/*
+ * Move the elements to a buffer of the given capacity, starting at its first
+ * slot.
+ */
+void ring_buffer::resize(size_t capacity) noexcept
+{
+    std::vector<element> elements(capacity);
+    for (size_t i = 0; i < _size; i++)
+    {
+        elements[i] = _elements[slot(i)];
+    }
+
+    _elements = std::move(elements);
+    _head     = 0;
+}
+
+void ring_buffer::shrink() noexcept
+{
+    auto capacity = _elements.size();
+    if (capacity > min_capacity && _size <= capacity / 4)
+    {
+        resize(capacity / 2);
+    }
+}
+
+void ring_buffer::push_front(const object& o) noexcept
+{
+    if (_size == _elements.size())
+    {
+        resize(std::max(min_capacity, _elements.size() * 2));
+    }
+
+    _head            = (_head - 1) & (_elements.size() - 1);
+    _elements[_head] = { o.box, o.type };
+    _size += 1;
+}
+
+void ring_buffer::push_back(const object& o) noexcept
+{
+    if (_size == _elements.size())
+    {
+        resize(std::max(min_capacity, _elements.size() * 2));
+    }
+
+    _elements[slot(_size)] = { o.box, o.type };
+    _size += 1;
+}
+
+object ring_buffer::pop_front() noexcept
+{
+    assert(_size > 0);
+
+    auto o = (*this)[0];
+    _head  = slot(1);
+    _size -= 1;
+
+    shrink();
+    return o;
+}
+
+object ring_buffer::pop_back() noexcept
+{
+    assert(_size > 0);
+
+    auto o = (*this)[_size - 1];
+    _size -= 1;
+
+    shrink();
+    return o;
+}
+
+object ring_buffer::operator[](size_t index) const noexcept
+{
+    const auto& e = _elements[slot(index)];
+    return { e.type, _span, e.box };
+}
+
+}
@@ -0,0 +1,30 @@
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+bool hash_set::insert(interpreter& interp, const object& key) noexcept
+{
+    return emplace_key(interp, key).second;
+}
+
+bool hash_set::remove(const object& key) noexcept
+{
+    auto index = find(key);
+    if (!index) return false;
+
+    erase(*index);
+    return true;
+}
+
+hash_set::const_iterator hash_set::begin() const noexcept
+{
+    return { *this, 0 };
+}
+
+hash_set::const_iterator hash_set::end() const noexcept
+{
+    return { *this, end_index() };
+}
+
+}
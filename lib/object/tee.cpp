@@ -0,0 +1,101 @@
+#include <algorithm>
+
+#include <nanbox.h>
+
+#include <eval.hpp>
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+tee_buffer::tee_buffer(object source) noexcept
+    : _source { source }
+    , _ring(16, invalid)
+{
+}
+
+size_t tee_buffer::add_cursor(size_t position) noexcept
+{
+    _cursors.push_back(position);
+    return _cursors.size() - 1;
+}
+
+size_t tee_buffer::position(size_t cursor) const noexcept
+{
+    return _cursors[cursor];
+}
+
+const object& tee_buffer::source() const noexcept
+{
+    return _source;
+}
+
+const std::vector<object>& tee_buffer::buffered() const noexcept
+{
+    return _ring;
+}
+
+object tee_buffer::next(interpreter& interp, span span, size_t cursor) noexcept
+{
+    auto position = _cursors[cursor];
+    object x      = invalid;
+
+    if (position < _first + _count)
+    {
+        x = _ring[(_head + position - _first) % _ring.size()];
+    }
+    else
+    {
+        if (_done) return create_unit(span);
+
+        x = gaya::eval::object::next(interp, span, _source);
+        if (!is_valid(x)) return x;
+
+        if (IS_UNIT(x))
+        {
+            _done = true;
+            return x;
+        }
+
+        push(x);
+    }
+
+    _cursors[cursor] = position + 1;
+    if (position == _first) trim();
+
+    return x;
+}
+
+void tee_buffer::push(object x) noexcept
+{
+    if (_count == _ring.size())
+    {
+        /* Unroll the ring into a buffer twice as big. */
+        std::vector<object> ring(_ring.size() * 2, invalid);
+        for (size_t i = 0; i < _count; i++)
+        {
+            ring[i] = _ring[(_head + i) % _ring.size()];
+        }
+
+        _ring = std::move(ring);
+        _head = 0;
+    }
+
+    _ring[(_head + _count) % _ring.size()] = x;
+    _count += 1;
+}
+
+void tee_buffer::trim() noexcept
+{
+    auto slowest = *std::min_element(_cursors.begin(), _cursors.end());
+
+    while (_count > 0 && _first < slowest)
+    {
+        _ring[_head] = invalid;
+        _head        = (_head + 1) % _ring.size();
+        _first += 1;
+        _count -= 1;
+    }
+}
+
+}
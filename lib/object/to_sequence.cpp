@@ -28,16 +28,44 @@ object to_sequence(interpreter& interp, object& o) noexcept
     }
     case object_type_array:
     {
-        return create_array_sequence(interp, o.span, AS_ARRAY(o));
+        return create_array_sequence(interp, o.span, o);
     }
     case object_type_dictionary:
     {
-        return create_dict_sequence(interp, o.span, AS_DICT(o));
+        return create_dict_sequence(interp, o.span, o);
+    }
+    case object_type_set:
+    {
+        return create_set_sequence(interp, o.span, o);
+    }
+    case object_type_typed_array:
+    {
+        return create_sequence(
+            interp,
+            sequence {
+                o.span,
+                sequence_type_typed_array,
+                typed_array_sequence { o },
+            });
+    }
+    case object_type_deque:
+    {
+        return create_sequence(
+            interp,
+            sequence { o.span, sequence_type_deque, deque_sequence { o } });
+    }
+    case object_type_tuple:
+    {
+        return create_sequence(
+            interp,
+            sequence { o.span, sequence_type_tuple, tuple_sequence { o } });
     }
     case object_type_function:
     case object_type_builtin_function:
     case object_type_struct:
     case object_type_enum:
+    case object_type_priority_queue:
+    case object_type_grid:
     case object_type_invalid:
     {
         assert(0 && "Should not happen");
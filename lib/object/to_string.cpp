@@ -1,5 +1,5 @@
 #include <cmath>
-#include <sstream>
+#include <iterator>
 
 #include <fmt/core.h>
 #include <nanbox.h>
@@ -9,93 +9,170 @@
 namespace gaya::eval::object
 {
 
-std::string struct_to_string(interpreter& interp, StructObject& struct_object)
+static void struct_to_string(
+    interpreter& interp,
+    StructObject& struct_object,
+    std::string& out)
 {
-    std::stringstream ss;
-
-    ss << struct_object.name;
-    ss << "(";
+    out += struct_object.name;
+    out += '(';
 
     for (size_t i = 0; i < struct_object.fields.size(); i++)
     {
         if (auto& field = struct_object.fields[i]; is_valid(field.value))
         {
-            ss << to_string(interp, field.value);
+            to_string(interp, field.value, out);
             if (i < struct_object.fields.size() - 1)
             {
-                ss << ", ";
+                out += ", ";
             }
         }
     }
 
-    ss << ")";
-
-    return ss.str();
+    out += ')';
 }
 
-std::string number_to_string(double number)
+static void number_to_string(double number, std::string& out)
 {
     double intval;
     auto has_decimals = std::modf(number, &intval) != 0.0;
-    return has_decimals ? fmt::format("{}", number)
-                        : fmt::format("{:.0f}", number);
+    if (has_decimals)
+    {
+        fmt::format_to(std::back_inserter(out), "{}", number);
+    }
+    else
+    {
+        fmt::format_to(std::back_inserter(out), "{:.0f}", number);
+    }
 }
 
-std::string
-array_to_string(interpreter& interp, const std::vector<object>& elems)
+/*
+ * Write out the elements of an array or a tuple, which look the same.
+ */
+template <typename Elements>
+static void
+array_to_string(interpreter& interp, const Elements& elems, std::string& out)
 {
-    std::stringstream ss;
-    ss << "(";
+    out += '(';
     for (size_t i = 0; i < elems.size(); i++)
     {
-        ss << to_string(interp, elems[i]);
+        to_string(interp, elems[i], out);
         if (i < elems.size() - 1)
         {
-            ss << ", ";
+            out += ", ";
         }
     }
-    ss << ")";
-    return ss.str();
+    out += ')';
 }
 
-std::string dict_to_string(
+static void dict_to_string(
     interpreter& interp,
-    const robin_hood::unordered_map<object, object>& dict)
+    const dictionary& dict,
+    std::string& out)
 {
     if (dict.empty())
     {
-        return "(->)";
+        out += "(->)";
+        return;
     }
 
-    std::stringstream ss;
-    ss << "(";
+    out += '(';
     std::size_t i = 0;
-    for (auto& it : dict)
+    for (const auto& [key, value] : dict)
     {
-        ss << to_string(interp, it.first) << " -> "
-           << to_string(interp, it.second);
+        to_string(interp, key, out);
+        out += " -> ";
+        to_string(interp, value, out);
 
         if (i < dict.size() - 1)
         {
-            ss << ", ";
+            out += ", ";
+        }
+
+        i += 1;
+    }
+    out += ')';
+}
+
+/*
+ * Write out a set the way it would be made, as in set((1, 2)).
+ */
+static void
+set_to_string(interpreter& interp, const hash_set& set, std::string& out)
+{
+    out += "set((";
+    std::size_t i = 0;
+    for (const auto& x : set)
+    {
+        to_string(interp, x, out);
+
+        if (i < set.size() - 1)
+        {
+            out += ", ";
         }
 
         i += 1;
     }
-    ss << ")";
-    return ss.str();
+    out += "))";
+}
+
+static void
+deque_to_string(interpreter& interp, const ring_buffer& deque, std::string& out)
+{
+    out += "deque(";
+    array_to_string(interp, deque, out);
+    out += ')';
 }
 
-std::string sequence_to_string(interpreter& interp, sequence& seq) noexcept
+static void typed_array_to_string(
+    interpreter& interp,
+    const typed_array& array,
+    std::string& out)
 {
-    std::stringstream ss;
+    out += array.element_kind() == typed_array::kind::float64
+        ? "typed.float64("
+        : "typed.int64(";
+    array_to_string(interp, array, out);
+    out += ')';
+}
 
-    ss << "(";
+/*
+ * Write out the rows of a grid on lines of their own, with string cells as
+ * they are, so that character grids look like the text they were read from.
+ */
+static void
+grid_to_string(interpreter& interp, const dense_grid& grid, std::string& out)
+{
+    for (size_t y = 0; y < grid.height(); y++)
+    {
+        if (y > 0) out += '\n';
+
+        for (size_t x = 0; x < grid.width(); x++)
+        {
+            auto cell = grid.at(x, y);
+            if (IS_STRING(cell))
+            {
+                out += AS_STRING(cell);
+            }
+            else
+            {
+                to_string(interp, cell, out);
+            }
+        }
+    }
+}
+
+static void sequence_to_string(
+    interpreter& interp,
+    sequence& seq,
+    std::string& out) noexcept
+{
+    out += '(';
 
     auto o = next(interp, seq);
     if (gaya::eval::object::is_valid(o) && o.type != object_type_unit)
     {
-        ss << to_string(interp, o);
+        to_string(interp, o, out);
 
         for (;;)
         {
@@ -103,59 +180,109 @@ std::string sequence_to_string(interpreter& interp, sequence& seq) noexcept
             if (!gaya::eval::object::is_valid(o) || o.type == object_type_unit)
                 break;
 
-            ss << ", " << to_string(interp, o);
+            out += ", ";
+            to_string(interp, o, out);
         }
     }
 
-    ss << ")";
-
-    return ss.str();
+    out += ')';
 }
 
-std::string to_string(interpreter& interp, object o) noexcept
+void to_string(interpreter& interp, object o, std::string& out) noexcept
 {
     switch (o.type)
     {
     case object_type_number:
     {
-        return number_to_string(AS_NUMBER(o));
+        number_to_string(AS_NUMBER(o), out);
+        return;
     }
     case object_type_unit:
     {
-        return "unit";
+        out += "unit";
+        return;
     }
     case object_type_string:
     {
-        return '"' + AS_STRING(o) + '"';
+        out += '"';
+        out += AS_STRING(o);
+        out += '"';
+        return;
     }
     case object_type_array:
     {
-        return array_to_string(interp, AS_ARRAY(o));
+        array_to_string(interp, AS_ARRAY(o), out);
+        return;
     }
     case object_type_dictionary:
     {
-        return dict_to_string(interp, AS_DICT(o));
+        dict_to_string(interp, AS_DICT(o), out);
+        return;
+    }
+    case object_type_tuple:
+    {
+        array_to_string(interp, AS_TUPLE(o), out);
+        return;
+    }
+    case object_type_set:
+    {
+        set_to_string(interp, AS_SET(o), out);
+        return;
     }
     case object_type_function:
     {
-        return fmt::format("<function-{}>", AS_FUNCTION(o).arity);
+        fmt::format_to(
+            std::back_inserter(out),
+            "<function-{}>",
+            AS_FUNCTION(o).arity);
+        return;
     }
     case object_type_builtin_function:
     {
         auto func_name = AS_BUILTIN_FUNCTION(o).name;
-        return fmt::format("<builtin-function: {}>", func_name);
+        fmt::format_to(
+            std::back_inserter(out),
+            "<builtin-function: {}>",
+            func_name);
+        return;
+    }
+    case object_type_deque:
+    {
+        deque_to_string(interp, AS_DEQUE(o), out);
+        return;
+    }
+    case object_type_grid:
+    {
+        grid_to_string(interp, AS_GRID(o), out);
+        return;
+    }
+    case object_type_typed_array:
+    {
+        typed_array_to_string(interp, AS_TYPED_ARRAY(o), out);
+        return;
+    }
+    case object_type_priority_queue:
+    {
+        fmt::format_to(
+            std::back_inserter(out),
+            "<priority-queue-{}>",
+            AS_PRIORITY_QUEUE(o).size());
+        return;
     }
     case object_type_sequence:
     {
-        return sequence_to_string(interp, AS_SEQUENCE(o));
+        sequence_to_string(interp, AS_SEQUENCE(o), out);
+        return;
     }
     case object_type_struct:
     {
-        return struct_to_string(interp, AS_STRUCT(o));
+        struct_to_string(interp, AS_STRUCT(o), out);
+        return;
     }
     case object_type_enum:
     {
-        return AS_ENUM(o).variant;
+        out += AS_ENUM(o).variant;
+        return;
     }
     case object_type_invalid:
     {
@@ -166,4 +293,11 @@ std::string to_string(interpreter& interp, object o) noexcept
     assert(0 && "unhandled case in to_string");
 }
 
+std::string to_string(interpreter& interp, object o) noexcept
+{
+    std::string out;
+    to_string(interp, o, out);
+    return out;
+}
+
 }
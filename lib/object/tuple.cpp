@@ -0,0 +1,68 @@
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+tuple::tuple(span span, const std::vector<object>& elems) noexcept
+    : _hash { elems.size() }
+    , _size { elems.size() }
+    , _span { span }
+    , _inline {}
+{
+    fill(elems);
+}
+
+tuple::tuple(span span, const packed_array& elems) noexcept
+    : _hash { elems.size() }
+    , _size { elems.size() }
+    , _span { span }
+    , _inline {}
+{
+    fill(elems);
+}
+
+template <typename Elements>
+void tuple::fill(const Elements& elems) noexcept
+{
+    element* out = _inline.data();
+    if (_size > inline_capacity)
+    {
+        _spilled.resize(_size);
+        out = _spilled.data();
+    }
+
+    for (size_t i = 0; i < _size; i++)
+    {
+        object elem = elems[i];
+        out[i]      = { elem.box, elem.type };
+        _hash       = hash_combine(_hash, gaya::eval::object::hash(elem));
+    }
+}
+
+size_t tuple::size() const noexcept
+{
+    return _size;
+}
+
+bool tuple::empty() const noexcept
+{
+    return _size == 0;
+}
+
+object tuple::operator[](size_t index) const noexcept
+{
+    const auto& e = elements()[index];
+    return { e.type, _span, e.box };
+}
+
+size_t tuple::hash() const noexcept
+{
+    return _hash;
+}
+
+const tuple::element* tuple::elements() const noexcept
+{
+    return _size > inline_capacity ? _spilled.data() : _inline.data();
+}
+
+}
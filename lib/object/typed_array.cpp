@@ -0,0 +1,74 @@
+#include <cassert>
+#include <cmath>
+
+#include <object.hpp>
+
+namespace gaya::eval::object
+{
+
+typed_array::typed_array(span span, kind kind) noexcept
+    : _kind { kind }
+    , _span { span }
+{
+}
+
+typed_array::kind typed_array::element_kind() const noexcept
+{
+    return _kind;
+}
+
+size_t typed_array::size() const noexcept
+{
+    return _kind == kind::float64 ? _float64s.size() : _int64s.size();
+}
+
+bool typed_array::empty() const noexcept
+{
+    return size() == 0;
+}
+
+double typed_array::at(size_t index) const noexcept
+{
+    return _kind == kind::float64 ? _float64s[index]
+                                  : static_cast<double>(_int64s[index]);
+}
+
+object typed_array::operator[](size_t index) const noexcept
+{
+    return create_number(_span, at(index));
+}
+
+void typed_array::push_back(double x) noexcept
+{
+    if (_kind == kind::float64)
+    {
+        _float64s.push_back(x);
+    }
+    else
+    {
+        assert(std::trunc(x) == x);
+        _int64s.push_back(static_cast<int64_t>(x));
+    }
+}
+
+std::vector<double>& typed_array::float64s() noexcept
+{
+    return _float64s;
+}
+
+const std::vector<double>& typed_array::float64s() const noexcept
+{
+    return _float64s;
+}
+
+std::vector<int64_t>& typed_array::int64s() noexcept
+{
+    return _int64s;
+}
+
+const std::vector<int64_t>& typed_array::int64s() const noexcept
+{
+    return _int64s;
+}
+
+}
@@ -27,6 +27,32 @@ std::string typeof_(const object& o) noexcept
     {
         return "Dictionary";
     }
+    case object_type_tuple:
+    {
+        return "Tuple";
+    }
+    case object_type_set:
+    {
+        return "Set";
+    }
+    case object_type_priority_queue:
+    {
+        return "PriorityQueue";
+    }
+    case object_type_deque:
+    {
+        return "Deque";
+    }
+    case object_type_grid:
+    {
+        return "Grid";
+    }
+    case object_type_typed_array:
+    {
+        return AS_TYPED_ARRAY(o).element_kind() == typed_array::kind::float64
+            ? "Float64Array"
+            : "Int64Array";
+    }
     case object_type_function:
     case object_type_builtin_function:
     {
@@ -0,0 +1,87 @@
+#include <cerrno>
+#include <cstdio>
+
+#include <output_buffer.hpp>
+
+namespace gaya
+{
+
+output_buffer::output_buffer(int fd, size_t capacity) noexcept
+    : _fd { fd }
+    , _capacity { capacity }
+{
+    _buffer.reserve(_capacity);
+}
+
+output_buffer::~output_buffer()
+{
+    flush();
+}
+
+void output_buffer::write(std::string_view text) noexcept
+{
+    _buffer.append(text);
+    commit();
+}
+
+void output_buffer::put(char c) noexcept
+{
+    _buffer.push_back(c);
+    commit();
+}
+
+std::string& output_buffer::pending() noexcept
+{
+    return _buffer;
+}
+
+void output_buffer::commit() noexcept
+{
+    if (_buffer.size() >= _capacity)
+    {
+        flush();
+    }
+}
+
+void output_buffer::flush() noexcept
+{
+    if (_buffer.empty()) return;
+
+    /*
+     * NOTE: Diagnostics and foreign functions still print through stdio, so
+     *       its buffer is emptied first to keep the output in order.
+     */
+    std::fflush(stdout);
+
+    const char* data = _buffer.data();
+    size_t remaining = _buffer.size();
+
+    while (remaining > 0)
+    {
+        auto written = ::write(_fd, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+
+    _buffer.clear();
+}
+
+void output_buffer::set_capacity(size_t capacity) noexcept
+{
+    flush();
+    _capacity = capacity;
+    _buffer.reserve(_capacity);
+}
+
+size_t output_buffer::capacity() const noexcept
+{
+    return _capacity;
+}
+
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include <fmt/core.h>
 
@@ -35,12 +36,18 @@ parser::parser()
     define("tosequence"s);
     define("issequence"s);
     define("md5"s);
+    define("tuple"s);
 
     define("io.println"s);
     define("io.print"s);
     define("io.readline"s);
+    define("io.stdin"s);
+    define("io.stdinChunks"s);
     define("io.readfile"s);
+    define("io.lines"s);
     define("io.listdir"s);
+    define("io.flush"s);
+    define("io.setBufferSize"s);
 
     define("string.length"s);
     define("string.concat"s);
@@ -50,6 +57,12 @@ parser::parser()
     define("string.startswith"s);
     define("string.endswith"s);
     define("string.trim"s);
+    define("string.split"s);
+    define("string.splitArray"s);
+    define("string.lines"s);
+    define("string.numbers"s);
+    define("string.integers"s);
+    define("string.integerLines"s);
 
     define("array.length"s);
     define("array.concat"s);
@@ -57,19 +70,113 @@ parser::parser()
     define("array.pop"s);
     define("array.sort"s);
     define("array.set"s);
+    define("array.slice"s);
+    define("array.clone"s);
 
     define("dict.length"s);
     define("dict.set"s);
     define("dict.remove"s);
+    define("dict.update"s);
+    define("dict.increment"s);
+    define("dict.getOrInsert"s);
+    define("dict.pop"s);
     define("dict.contains"s);
+    define("dict.keys"s);
+    define("dict.values"s);
+    define("dict.items"s);
+    define("dict.clone"s);
+
+    define("set"s);
+    define("set.length"s);
+    define("set.add"s);
+    define("set.remove"s);
+    define("set.contains"s);
+    define("set.union"s);
+    define("set.intersection"s);
+    define("set.difference"s);
+
+    define("pq.new"s);
+    define("pq.length"s);
+    define("pq.push"s);
+    define("pq.pop"s);
+    define("pq.peek"s);
+    define("pq.priority"s);
+    define("pq.decrease"s);
+
+    define("deque"s);
+    define("deque.length"s);
+    define("deque.pushFront"s);
+    define("deque.pushBack"s);
+    define("deque.popFront"s);
+    define("deque.popBack"s);
+
+    define("grid.new"s);
+    define("grid.fromString"s);
+    define("grid.width"s);
+    define("grid.height"s);
+    define("grid.get"s);
+    define("grid.set"s);
+    define("grid.neighbours"s);
+    define("grid.neighbours8"s);
+    define("grid.row"s);
+    define("grid.column"s);
+    define("grid.find"s);
+    define("grid.findAll"s);
+    define("grid.floodFill"s);
+    define("grid.copy"s);
+
+    define("typed.float64"s);
+    define("typed.int64"s);
+    define("typed.length"s);
+    define("typed.sum"s);
+    define("typed.min"s);
+    define("typed.max"s);
+    define("typed.dot"s);
+    define("typed.prefixSum"s);
+    define("typed.add"s);
+    define("typed.mul"s);
+    define("typed.scale"s);
+    define("typed.sort"s);
+    define("typed.toArray"s);
 
     define("seq.next"s);
     define("seq.make"s);
     define("seq.copy"s);
+    define("seq.range"s);
+    define("seq.map"s);
+    define("seq.filter"s);
+    define("seq.take"s);
+    define("seq.drop"s);
+    define("seq.takewhile"s);
+    define("seq.dropwhile"s);
+    define("seq.enumerate"s);
+    define("seq.flatten"s);
+    define("seq.concatMap"s);
+    define("seq.foreach"s);
+    define("seq.reduce"s);
+    define("seq.sum"s);
+    define("seq.count"s);
+    define("seq.groupBy"s);
+    define("seq.countBy"s);
+    define("seq.histogram"s);
+    define("seq.unique"s);
+    define("seq.any"s);
+    define("seq.all"s);
+    define("seq.min"s);
+    define("seq.max"s);
+    define("seq.toarray"s);
+    define("seq.inits"s);
+    define("seq.tails"s);
+    define("seq.tee"s);
 
     define("math.ceil"s);
     define("math.floor"s);
 
+    define("re.match"s);
+    define("re.findall"s);
+    define("re.captures"s);
+    define("re.split"s);
+
     define("system.args"s);
     define("aoc.getInput"s);
 }
@@ -586,7 +693,10 @@ ast::stmt_ptr parser::for_in_stmt(token for_) noexcept
 
     begin_scope();
 
-    auto ident = _lexer.next_token();
+    auto ident        = _lexer.next_token();
+    auto destructures = match(ident, token_type::lparen);
+    if (destructures) ident = _lexer.next_token();
+
     if (!match(ident, token_type::identifier))
     {
         parser_error(for_.span, "Expected an identifier after 'for'");
@@ -598,6 +708,48 @@ ast::stmt_ptr parser::for_in_stmt(token for_) noexcept
         = ast::make_node<ast::identifier>(ident->span, ident->span.to_string());
     define(identifier->key);
 
+    std::shared_ptr<ast::identifier> value_identifier = nullptr;
+
+    if (destructures)
+    {
+        if (!match(token_type::comma))
+        {
+            parser_error(for_.span, "Expected ',' after key in for-loop");
+            end_scope();
+            return nullptr;
+        }
+
+        auto value = _lexer.next_token();
+        if (!match(value, token_type::identifier))
+        {
+            parser_error(for_.span, "Expected an identifier after ','");
+            end_scope();
+            return nullptr;
+        }
+
+        value_identifier = ast::make_node<ast::identifier>(
+            value->span,
+            value->span.to_string());
+
+        if (value_identifier->value == identifier->value)
+        {
+            parser_error(
+                value->span,
+                "Key and value of a for-loop must have different names");
+            end_scope();
+            return nullptr;
+        }
+
+        define(value_identifier->key);
+
+        if (!match(token_type::rparen))
+        {
+            parser_error(for_.span, "Expected ')' after value in for-loop");
+            end_scope();
+            return nullptr;
+        }
+    }
+
     if (!match(token_type::in))
     {
         parser_error(for_.span, "Expected 'in' after identifier in for-loop");
@@ -658,7 +810,8 @@ ast::stmt_ptr parser::for_in_stmt(token for_) noexcept
         for_.span,
         std::move(identifier),
         std::move(e),
-        std::move(body));
+        std::move(body),
+        std::move(value_identifier));
 }
 
 ast::stmt_ptr parser::declaration_stmt(token identifier)
@@ -978,6 +1131,8 @@ ast::expression_ptr parser::expression(token token)
     {
     case token_type::do_: return do_expression(token);
     case token_type::cases: return case_expression(token);
+    case token_type::gen: return generator_expression(token);
+    case token_type::yield_: return yield_expression(token);
     default:
     {
         auto stmt_expr = try_parse_statement_as_expression(token);
@@ -1555,7 +1710,10 @@ ast::expression_ptr parser::perform_expression(token op) noexcept
 std::shared_ptr<ast::function_expression>
 parser::finish_trailing_function(span span, token lparen) noexcept
 {
-    auto function = function_expression(lparen);
+    auto in_generator = std::exchange(_in_generator, false);
+    auto function     = function_expression(lparen);
+    _in_generator     = in_generator;
+
     if (!function)
     {
         parser_error(span, "Expected a trailing function expression");
@@ -2314,6 +2472,42 @@ ast::expression_ptr parser::do_expression(token token)
     return ast::make_node<ast::do_expression>(token.span, std::move(body));
 }
 
+ast::expression_ptr parser::generator_expression(token gen)
+{
+    assert(gen.type == token_type::gen);
+
+    auto in_generator = std::exchange(_in_generator, true);
+    auto body         = do_expression(gen);
+    _in_generator     = in_generator;
+
+    if (!body) return nullptr;
+
+    return ast::make_node<ast::generator_expression>(gen.span, body);
+}
+
+ast::expression_ptr parser::yield_expression(token yield)
+{
+    assert(yield.type == token_type::yield_);
+
+    if (!_in_generator)
+    {
+        parser_error(yield.span, "'yield' can only be used inside a generator");
+        return nullptr;
+    }
+
+    auto token = _lexer.next_token();
+    if (!token)
+    {
+        parser_error(yield.span, "Expected an expression after 'yield'");
+        return nullptr;
+    }
+
+    auto expr = expression(*token);
+    if (!expr) return nullptr;
+
+    return ast::make_node<ast::yield_expression>(yield.span, expr);
+}
+
 ast::expression_ptr parser::primary_expression(token token)
 {
     switch (token.type)
@@ -2341,7 +2535,11 @@ ast::expression_ptr parser::primary_expression(token token)
     }
     case token_type::lcurly:
     {
-        return function_expression(token);
+        /* A function inside a generator cannot yield for it. */
+        auto in_generator = std::exchange(_in_generator, false);
+        auto function     = function_expression(token);
+        _in_generator     = in_generator;
+        return function;
     }
     case token_type::let:
     {
@@ -0,0 +1,854 @@
+#include <cctype>
+#include <cstring>
+
+#include <fmt/core.h>
+
+#include <regex.hpp>
+
+namespace gaya::regex
+{
+
+static constexpr size_t npos               = std::string_view::npos;
+static constexpr size_t max_repetitions    = 1000;
+static constexpr size_t max_program_length = 100000;
+
+using char_set = std::bitset<256>;
+
+enum class node_kind {
+    empty,
+    literal,
+    char_class,
+    concat,
+    alternate,
+    repeat,
+    group,
+    begin,
+    end,
+    word_boundary,
+};
+
+struct node
+{
+    node_kind kind = node_kind::empty;
+    char c         = 0;
+    size_t index   = 0;
+    size_t min     = 0;
+    size_t max     = 0;
+    bool greedy    = true;
+    size_t group   = npos;
+    std::vector<node> children {};
+};
+
+static bool is_word_char(char c) noexcept
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static char_set digits() noexcept
+{
+    char_set set;
+    for (char c = '0'; c <= '9'; c++) set.set(static_cast<unsigned char>(c));
+    return set;
+}
+
+static char_set word_chars() noexcept
+{
+    char_set set;
+    for (int c = 0; c < 256; c++)
+    {
+        if (is_word_char(static_cast<char>(c))) set.set(c);
+    }
+    return set;
+}
+
+static char_set whitespace() noexcept
+{
+    char_set set;
+    for (char c : std::string_view { " \t\n\r\f\v" })
+    {
+        set.set(static_cast<unsigned char>(c));
+    }
+    return set;
+}
+
+class compiler
+{
+public:
+    compiler(std::string_view pattern, program& prog)
+        : _pattern { pattern }
+        , _program { prog }
+    {
+    }
+
+    [[nodiscard]] std::optional<std::string> compile() noexcept
+    {
+        auto root = parse_alternation();
+        if (_error) return _error;
+
+        if (_pos < _pattern.size())
+        {
+            return fmt::format("unmatched ')' at position {}", _pos);
+        }
+
+        emit_instruction({ .op = opcode::save, .x = 0 });
+        emit(root);
+        emit_instruction({ .op = opcode::save, .x = 1 });
+        emit_instruction({ .op = opcode::match });
+
+        if (_program._instructions.size() > max_program_length)
+        {
+            return "pattern is too large";
+        }
+
+        _program._groups = _groups;
+        if (_program._instructions[1].op == opcode::character)
+        {
+            _program._first_char = _program._instructions[1].c;
+        }
+
+        return {};
+    }
+
+private:
+    [[nodiscard]] bool at_end() const noexcept
+    {
+        return _pos >= _pattern.size();
+    }
+
+    [[nodiscard]] char peek() const noexcept
+    {
+        return at_end() ? '\0' : _pattern[_pos];
+    }
+
+    void error(const std::string& message) noexcept
+    {
+        if (!_error)
+        {
+            _error = fmt::format("{} at position {}", message, _pos);
+        }
+    }
+
+    [[nodiscard]] node parse_alternation() noexcept
+    {
+        auto first = parse_concat();
+        if (peek() != '|') return first;
+
+        node alternation { .kind = node_kind::alternate };
+        alternation.children.push_back(std::move(first));
+
+        while (!_error && peek() == '|')
+        {
+            _pos += 1;
+            alternation.children.push_back(parse_concat());
+        }
+
+        return alternation;
+    }
+
+    [[nodiscard]] node parse_concat() noexcept
+    {
+        node concat { .kind = node_kind::concat };
+
+        while (!_error && !at_end() && peek() != '|' && peek() != ')')
+        {
+            concat.children.push_back(parse_repeat());
+        }
+
+        return concat;
+    }
+
+    [[nodiscard]] bool parse_count(size_t* n) noexcept
+    {
+        if (!std::isdigit(static_cast<unsigned char>(peek()))) return false;
+
+        *n = 0;
+        while (std::isdigit(static_cast<unsigned char>(peek())))
+        {
+            *n = *n * 10 + (peek() - '0');
+            _pos += 1;
+
+            if (*n > max_repetitions)
+            {
+                auto limit = max_repetitions;
+                error(fmt::format("repetition count exceeds {}", limit));
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] node parse_repeat() noexcept
+    {
+        auto atom = parse_atom();
+
+        while (!_error && !at_end())
+        {
+            size_t min = 0;
+            size_t max = npos;
+
+            switch (peek())
+            {
+            case '*': _pos += 1; break;
+            case '+':
+                _pos += 1;
+                min = 1;
+                break;
+            case '?':
+                _pos += 1;
+                max = 1;
+                break;
+            case '{':
+            {
+                _pos += 1;
+                if (!parse_count(&min))
+                {
+                    error("expected a number after '{'");
+                    return atom;
+                }
+
+                max = min;
+                if (peek() == ',')
+                {
+                    _pos += 1;
+                    max = npos;
+                    if (peek() != '}' && !parse_count(&max))
+                    {
+                        error("expected a number or '}' after ','");
+                        return atom;
+                    }
+                }
+
+                if (peek() != '}')
+                {
+                    error("expected '}'");
+                    return atom;
+                }
+                _pos += 1;
+
+                if (max < min)
+                {
+                    error("invalid repetition range");
+                    return atom;
+                }
+                break;
+            }
+            default: return atom;
+            }
+
+            bool greedy = true;
+            if (peek() == '?')
+            {
+                _pos += 1;
+                greedy = false;
+            }
+
+            node repeat {
+                .kind   = node_kind::repeat,
+                .min    = min,
+                .max    = max,
+                .greedy = greedy,
+            };
+            repeat.children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+
+        return atom;
+    }
+
+    [[nodiscard]] node class_node(char_set set) noexcept
+    {
+        _program._classes.push_back(set);
+        return node {
+            .kind  = node_kind::char_class,
+            .index = _program._classes.size() - 1,
+        };
+    }
+
+    /* Parse the escape after a '\', returning whether it named a set. */
+    [[nodiscard]] bool parse_escape(char* c, char_set* set) noexcept
+    {
+        if (at_end())
+        {
+            error("trailing '\\'");
+            return false;
+        }
+
+        auto escaped = _pattern[_pos++];
+        switch (escaped)
+        {
+        case 'd': *set = digits(); return true;
+        case 'D': *set = ~digits(); return true;
+        case 'w': *set = word_chars(); return true;
+        case 'W': *set = ~word_chars(); return true;
+        case 's': *set = whitespace(); return true;
+        case 'S': *set = ~whitespace(); return true;
+        case 'n': *c = '\n'; return false;
+        case 't': *c = '\t'; return false;
+        case 'r': *c = '\r'; return false;
+        default: *c = escaped; return false;
+        }
+    }
+
+    [[nodiscard]] node parse_class() noexcept
+    {
+        char_set set;
+        bool negated = false;
+
+        if (peek() == '^')
+        {
+            negated = true;
+            _pos += 1;
+        }
+
+        bool first = true;
+        while (!at_end() && (peek() != ']' || first))
+        {
+            first  = false;
+            char c = _pattern[_pos++];
+
+            if (c == '\\')
+            {
+                char_set escaped;
+                if (parse_escape(&c, &escaped))
+                {
+                    set |= escaped;
+                    continue;
+                }
+                if (_error) return {};
+            }
+
+            if (peek() == '-' && _pos + 1 < _pattern.size()
+                && _pattern[_pos + 1] != ']')
+            {
+                _pos += 1;
+                char last = _pattern[_pos++];
+                if (last == '\\')
+                {
+                    char_set escaped;
+                    if (parse_escape(&last, &escaped))
+                    {
+                        error("invalid range in character class");
+                        return {};
+                    }
+                }
+
+                auto lo = static_cast<unsigned char>(c);
+                auto hi = static_cast<unsigned char>(last);
+                if (hi < lo)
+                {
+                    error("invalid range in character class");
+                    return {};
+                }
+
+                for (unsigned i = lo; i <= hi; i++) set.set(i);
+            }
+            else
+            {
+                set.set(static_cast<unsigned char>(c));
+            }
+        }
+
+        if (at_end())
+        {
+            error("missing ']'");
+            return {};
+        }
+        _pos += 1;
+
+        return class_node(negated ? ~set : set);
+    }
+
+    [[nodiscard]] node parse_atom() noexcept
+    {
+        auto c = _pattern[_pos++];
+
+        switch (c)
+        {
+        case '(':
+        {
+            size_t group = npos;
+            if (_pattern.substr(_pos).starts_with("?:"))
+            {
+                _pos += 2;
+            }
+            else
+            {
+                group = ++_groups;
+            }
+
+            auto inner = parse_alternation();
+            if (peek() != ')')
+            {
+                error("missing ')'");
+                return {};
+            }
+            _pos += 1;
+
+            node group_node { .kind = node_kind::group, .group = group };
+            group_node.children.push_back(std::move(inner));
+            return group_node;
+        }
+        case '[':
+        {
+            return parse_class();
+        }
+        case '.':
+        {
+            char_set set;
+            set.set();
+            set.reset('\n');
+            return class_node(set);
+        }
+        case '^': return node { .kind = node_kind::begin };
+        case '$': return node { .kind = node_kind::end };
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        {
+            _pos -= 1;
+            error(fmt::format("nothing to repeat with '{}'", c));
+            return {};
+        }
+        case '\\':
+        {
+            if (peek() == 'b')
+            {
+                _pos += 1;
+                return node { .kind = node_kind::word_boundary };
+            }
+
+            char_set set;
+            if (parse_escape(&c, &set)) return class_node(set);
+            return node { .kind = node_kind::literal, .c = c };
+        }
+        default: return node { .kind = node_kind::literal, .c = c };
+        }
+    }
+
+    size_t emit_instruction(instruction inst) noexcept
+    {
+        _program._instructions.push_back(inst);
+        return _program._instructions.size() - 1;
+    }
+
+    [[nodiscard]] size_t pc() const noexcept
+    {
+        return _program._instructions.size();
+    }
+
+    void emit(const node& n) noexcept
+    {
+        /* Give up early on patterns that blow up while expanding counts. */
+        if (pc() > max_program_length) return;
+
+        auto& instructions = _program._instructions;
+
+        switch (n.kind)
+        {
+        case node_kind::empty: break;
+        case node_kind::literal:
+        {
+            emit_instruction({ .op = opcode::character, .c = n.c });
+            break;
+        }
+        case node_kind::char_class:
+        {
+            emit_instruction({ .op = opcode::char_class, .x = n.index });
+            break;
+        }
+        case node_kind::concat:
+        {
+            for (const auto& child : n.children) emit(child);
+            break;
+        }
+        case node_kind::alternate:
+        {
+            std::vector<size_t> jumps;
+            for (size_t i = 0; i < n.children.size(); i++)
+            {
+                if (i == n.children.size() - 1)
+                {
+                    emit(n.children[i]);
+                    break;
+                }
+
+                auto split = emit_instruction({ .op = opcode::split });
+                instructions[split].x = pc();
+                emit(n.children[i]);
+                jumps.push_back(emit_instruction({ .op = opcode::jump }));
+                instructions[split].y = pc();
+            }
+
+            for (auto jump : jumps) instructions[jump].x = pc();
+            break;
+        }
+        case node_kind::repeat:
+        {
+            const auto& child = n.children[0];
+
+            for (size_t i = 0; i < n.min; i++) emit(child);
+
+            if (n.max == npos)
+            {
+                auto split = emit_instruction({ .op = opcode::split });
+                emit(child);
+                emit_instruction({ .op = opcode::jump, .x = split });
+                instructions[split].x = split + 1;
+                instructions[split].y = pc();
+                if (!n.greedy)
+                {
+                    std::swap(instructions[split].x, instructions[split].y);
+                }
+                break;
+            }
+
+            /* x{n,m} is x repeated n times followed by (x(x(x)?)?)?. */
+            std::vector<size_t> splits;
+            for (size_t i = n.min; i < n.max; i++)
+            {
+                splits.push_back(emit_instruction({ .op = opcode::split }));
+                emit(child);
+            }
+
+            for (auto split : splits)
+            {
+                instructions[split].x = split + 1;
+                instructions[split].y = pc();
+                if (!n.greedy)
+                {
+                    std::swap(instructions[split].x, instructions[split].y);
+                }
+            }
+            break;
+        }
+        case node_kind::group:
+        {
+            if (n.group == npos)
+            {
+                emit(n.children[0]);
+                break;
+            }
+
+            emit_instruction({ .op = opcode::save, .x = 2 * n.group });
+            emit(n.children[0]);
+            emit_instruction({ .op = opcode::save, .x = 2 * n.group + 1 });
+            break;
+        }
+        case node_kind::begin:
+        {
+            emit_instruction({ .op = opcode::assert_begin });
+            break;
+        }
+        case node_kind::end:
+        {
+            emit_instruction({ .op = opcode::assert_end });
+            break;
+        }
+        case node_kind::word_boundary:
+        {
+            emit_instruction({ .op = opcode::word_boundary });
+            break;
+        }
+        }
+    }
+
+    std::string_view _pattern;
+    program& _program;
+    size_t _pos    = 0;
+    size_t _groups = 0;
+    std::optional<std::string> _error;
+};
+
+std::variant<program, std::string>
+program::compile(std::string_view pattern) noexcept
+{
+    program prog;
+    compiler c { pattern, prog };
+
+    if (auto error = c.compile(); error)
+    {
+        return *error;
+    }
+
+    return prog;
+}
+
+size_t program::groups() const noexcept
+{
+    return _groups;
+}
+
+std::optional<std::string_view>
+match::group(std::string_view subject, size_t n) const noexcept
+{
+    auto start = slots[2 * n];
+    auto end   = slots[2 * n + 1];
+
+    if (start == npos || end == npos) return {};
+
+    return subject.substr(start, end - start);
+}
+
+namespace
+{
+
+/*
+ * The threads alive at one position of the input, in priority order. Each
+ * thread has its own copy of the capture slots.
+ */
+class thread_list
+{
+public:
+    thread_list(size_t program_length, size_t slots)
+        : _slots { slots }
+        , _visited(program_length, 0)
+    {
+        _pcs.reserve(program_length);
+        _captures.reserve(program_length * slots);
+    }
+
+    void clear() noexcept
+    {
+        _pcs.clear();
+        _captures.clear();
+        _generation += 1;
+    }
+
+    /* Mark pc as visited, returning false if it already was. */
+    [[nodiscard]] bool visit(size_t pc) noexcept
+    {
+        if (_visited[pc] == _generation) return false;
+        _visited[pc] = _generation;
+        return true;
+    }
+
+    void push(size_t pc, const std::vector<size_t>& captures) noexcept
+    {
+        _pcs.push_back(pc);
+        _captures.insert(_captures.end(), captures.begin(), captures.end());
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _pcs.size();
+    }
+
+    [[nodiscard]] size_t pc(size_t i) const noexcept
+    {
+        return _pcs[i];
+    }
+
+    [[nodiscard]] const size_t* captures(size_t i) const noexcept
+    {
+        return _captures.data() + i * _slots;
+    }
+
+private:
+    size_t _slots;
+    std::vector<size_t> _pcs;
+    std::vector<size_t> _captures;
+    std::vector<size_t> _visited;
+    size_t _generation = 1;
+};
+
+struct frame
+{
+    bool restore;
+    size_t value;
+    size_t old = 0;
+};
+
+}
+
+/*
+ * Follow the empty transitions from pc and add the resulting threads to the
+ * list. An explicit stack keeps deeply nested patterns from overflowing the
+ * native one.
+ */
+static void add_thread(
+    const std::vector<instruction>& instructions,
+    thread_list& list,
+    std::vector<frame>& stack,
+    size_t start_pc,
+    std::string_view subject,
+    size_t pos,
+    std::vector<size_t>& captures) noexcept
+{
+    stack.clear();
+    stack.push_back({ .restore = false, .value = start_pc });
+
+    while (!stack.empty())
+    {
+        auto top = stack.back();
+        stack.pop_back();
+
+        if (top.restore)
+        {
+            captures[top.value] = top.old;
+            continue;
+        }
+
+        auto pc = top.value;
+        if (!list.visit(pc)) continue;
+
+        const auto& inst = instructions[pc];
+        switch (inst.op)
+        {
+        case opcode::jump:
+        {
+            stack.push_back({ .restore = false, .value = inst.x });
+            break;
+        }
+        case opcode::split:
+        {
+            stack.push_back({ .restore = false, .value = inst.y });
+            stack.push_back({ .restore = false, .value = inst.x });
+            break;
+        }
+        case opcode::save:
+        {
+            stack.push_back({
+                .restore = true,
+                .value   = inst.x,
+                .old     = captures[inst.x],
+            });
+            captures[inst.x] = pos;
+            stack.push_back({ .restore = false, .value = pc + 1 });
+            break;
+        }
+        case opcode::assert_begin:
+        {
+            if (pos == 0)
+            {
+                stack.push_back({ .restore = false, .value = pc + 1 });
+            }
+            break;
+        }
+        case opcode::assert_end:
+        {
+            if (pos == subject.size())
+            {
+                stack.push_back({ .restore = false, .value = pc + 1 });
+            }
+            break;
+        }
+        case opcode::word_boundary:
+        {
+            bool before = pos > 0 && is_word_char(subject[pos - 1]);
+            bool after  = pos < subject.size() && is_word_char(subject[pos]);
+            if (before != after)
+            {
+                stack.push_back({ .restore = false, .value = pc + 1 });
+            }
+            break;
+        }
+        case opcode::character:
+        case opcode::char_class:
+        case opcode::match:
+        {
+            list.push(pc, captures);
+            break;
+        }
+        }
+    }
+}
+
+std::optional<match>
+program::search(std::string_view subject, size_t start) const noexcept
+{
+    auto slots = 2 * (_groups + 1);
+
+    thread_list current { _instructions.size(), slots };
+    thread_list next { _instructions.size(), slots };
+    std::vector<frame> stack;
+    std::vector<size_t> captures(slots, npos);
+    std::optional<match> result;
+
+    for (auto pos = start; pos <= subject.size(); pos++)
+    {
+        if (!result)
+        {
+            if (current.size() == 0 && _first_char)
+            {
+                /* No thread is alive, so jump to the next possible start. */
+                const auto* found = std::memchr(
+                    subject.data() + pos,
+                    *_first_char,
+                    subject.size() - pos);
+                if (!found) break;
+                pos = static_cast<const char*>(found) - subject.data();
+            }
+
+            std::fill(captures.begin(), captures.end(), npos);
+            add_thread(
+                _instructions,
+                current,
+                stack,
+                0,
+                subject,
+                pos,
+                captures);
+        }
+
+        if (current.size() == 0)
+        {
+            if (result) break;
+            current.clear();
+            continue;
+        }
+
+        for (size_t i = 0; i < current.size(); i++)
+        {
+            auto pc          = current.pc(i);
+            const auto& inst = _instructions[pc];
+            const auto* caps = current.captures(i);
+
+            bool advance = false;
+            switch (inst.op)
+            {
+            case opcode::character:
+            {
+                advance = pos < subject.size() && subject[pos] == inst.c;
+                break;
+            }
+            case opcode::char_class:
+            {
+                advance = pos < subject.size()
+                    && _classes[inst.x].test(
+                        static_cast<unsigned char>(subject[pos]));
+                break;
+            }
+            case opcode::match:
+            {
+                /* Lower priority threads can't produce a preferred match. */
+                result = match { { caps, caps + slots } };
+                i      = current.size();
+                break;
+            }
+            default: break;
+            }
+
+            if (advance)
+            {
+                captures.assign(caps, caps + slots);
+                add_thread(
+                    _instructions,
+                    next,
+                    stack,
+                    pc + 1,
+                    subject,
+                    pos + 1,
+                    captures);
+            }
+        }
+
+        std::swap(current, next);
+        next.clear();
+    }
+
+    return result;
+}
+
+}
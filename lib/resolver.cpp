@@ -233,6 +233,20 @@ Resolver::visit_perform_expression(ast::perform_expression& perform)
     return eval::object::invalid;
 }
 
+eval::object::object
+Resolver::visit_generator_expression(ast::generator_expression& generator)
+{
+    generator.body->accept(*this);
+    return eval::object::invalid;
+}
+
+eval::object::object
+Resolver::visit_yield_expression(ast::yield_expression& yield)
+{
+    yield.expr->accept(*this);
+    return eval::object::invalid;
+}
+
 eval::object::object
 Resolver::visit_less_than_numbers(ast::LessThanNumbers& less_than_nums)
 {
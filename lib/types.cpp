@@ -59,6 +59,40 @@ bool Type::check(eval::interpreter& interp, const eval::object::object& o)
         type_ok = IS_STRING(o);
         break;
     }
+    case TypeKind::Set:
+    {
+        type_ok = IS_SET(o);
+        break;
+    }
+    case TypeKind::Deque:
+    {
+        type_ok = IS_DEQUE(o);
+        break;
+    }
+    case TypeKind::Grid:
+    {
+        type_ok = IS_GRID(o);
+        break;
+    }
+    case TypeKind::Float64Array:
+    {
+        type_ok = IS_TYPED_ARRAY(o)
+            && AS_TYPED_ARRAY(o).element_kind()
+                == eval::object::typed_array::kind::float64;
+        break;
+    }
+    case TypeKind::Int64Array:
+    {
+        type_ok = IS_TYPED_ARRAY(o)
+            && AS_TYPED_ARRAY(o).element_kind()
+                == eval::object::typed_array::kind::int64;
+        break;
+    }
+    case TypeKind::Tuple:
+    {
+        type_ok = IS_TUPLE(o);
+        break;
+    }
     case TypeKind::Unit:
     {
         type_ok = IS_UNIT(o);
@@ -104,13 +138,19 @@ std::string Type::to_string() const noexcept
     {
     case TypeKind::Any: return "Any";
     case TypeKind::Array: return "Array";
+    case TypeKind::Deque: return "Deque";
     case TypeKind::Dictionary: return "Dictionary";
     case TypeKind::Enum: return "Enum";
+    case TypeKind::Float64Array: return "Float64Array";
     case TypeKind::Function: return "Function";
+    case TypeKind::Grid: return "Grid";
+    case TypeKind::Int64Array: return "Int64Array";
     case TypeKind::Number: return "Number";
     case TypeKind::Sequence: return "Sequence";
+    case TypeKind::Set: return "Set";
     case TypeKind::String: return "String";
     case TypeKind::Struct: return "Struct";
+    case TypeKind::Tuple: return "Tuple";
     case TypeKind::Unit: return "Unit";
     }
 
@@ -133,6 +173,18 @@ std::optional<Type> Type::from_string(const std::string& s) noexcept
         return Type { TypeKind::Sequence };
     else if (s == "String")
         return Type { TypeKind::String };
+    else if (s == "Set")
+        return Type { TypeKind::Set };
+    else if (s == "Tuple")
+        return Type { TypeKind::Tuple };
+    else if (s == "Deque")
+        return Type { TypeKind::Deque };
+    else if (s == "Grid")
+        return Type { TypeKind::Grid };
+    else if (s == "Float64Array")
+        return Type { TypeKind::Float64Array };
+    else if (s == "Int64Array")
+        return Type { TypeKind::Int64Array };
     else
         return {};
 }
@@ -59,6 +59,8 @@ static bool run_repl_flag   = false;
             continue;
         }
 
+        interp.output().flush();
+
         auto result = object.value();
         auto show   = gaya::eval::object::to_string(interp, result);
         fmt::println("= {}", show);
@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
@@ -86,6 +87,13 @@ auto main() -> int
     size_t successes = 0;
     size_t failures  = 0;
 
+    /* Tests of io.stdin read this file, which is read by only one of them. */
+    if (!std::freopen("tests/stdin.txt", "r", stdin))
+    {
+        fmt::println("Could not open tests/stdin.txt");
+        std::exit(1);
+    }
+
     for (auto entry : fs::directory_iterator("tests"))
     {
         auto filename = entry.path().string();